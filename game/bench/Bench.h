@@ -0,0 +1,48 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// Helpers shared by the console benchmarks in game/bench
+
+struct BenchTimer
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    void Reset()
+    {
+        start = std::chrono::steady_clock::now();
+    }
+
+    double Seconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+// Stops the optimizer from discarding work whose result is otherwise unused
+volatile float benchSink = 0.0f;
+
+void Consume(float value)
+{
+    benchSink = benchSink + value;
+}
+
+float RandomFloat(float min, float max)
+{
+    return min + (max - min) * (rand() / (float)RAND_MAX);
+}
+
+// ns per element of op over count elements, repeated until about 0.2 s has passed
+template<typename Op>
+double Time(int count, Op op)
+{
+    BenchTimer timer;
+    int repeats = 0;
+    do
+    {
+        op();
+        repeats++;
+    } while (timer.Seconds() < 0.2);
+    return timer.Seconds() * 1e9 / ((double)repeats * count);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "Math.h"
+#include <algorithm>
+#include <cmath>
+
+// Double precision references shared by the benchmarks that check Math.h accuracy
+
+// Gauss-Jordan with partial pivoting in double precision; returns the determinant
+double ReferenceInvert(const Matrix& mat, double inverse[16])
+{
+    double a[4][8];
+    const float* m = &mat.m0;
+    for (int r = 0; r < 4; r++)
+        for (int c = 0; c < 4; c++)
+        {
+            a[r][c] = m[4 * r + c];
+            a[r][c + 4] = (r == c) ? 1.0 : 0.0;
+        }
+
+    double det = 1.0;
+    for (int c = 0; c < 4; c++)
+    {
+        int pivot = c;
+        for (int r = c + 1; r < 4; r++)
+            if (fabs(a[r][c]) > fabs(a[pivot][c])) pivot = r;
+        if (pivot != c)
+        {
+            for (int k = 0; k < 8; k++) std::swap(a[c][k], a[pivot][k]);
+            det = -det;
+        }
+
+        det *= a[c][c];
+        const double scale = 1.0 / a[c][c];
+        for (int k = 0; k < 8; k++) a[c][k] *= scale;
+        for (int r = 0; r < 4; r++)
+        {
+            if (r == c) continue;
+            const double factor = a[r][c];
+            for (int k = 0; k < 8; k++) a[r][k] -= factor * a[c][k];
+        }
+    }
+
+    for (int r = 0; r < 4; r++)
+        for (int c = 0; c < 4; c++) inverse[4 * r + c] = a[r][c + 4];
+    return det;
+}
@@ -0,0 +1,121 @@
+#include "Bench.h"
+#include "Physics.h"
+
+#include <vector>
+#include <cmath>
+
+// Accuracy and cost of each integrator policy on two problems with analytic solutions:
+// a circular orbit around a unit point mass and an undamped unit spring.
+// Pick the cheapest integrator whose error stays acceptable at the dt you want to run.
+// Rows whose position error exceeds 0.1 (10% of the orbit radius) are flagged.
+
+struct Orbit
+{
+    static const char* Name() { return "orbit"; }
+
+    // r = 1, v = 1, GM = 1 -> period 2pi
+    static void Initial(Vector2& pos, Vector2& vel)
+    {
+        pos = { 1.0f, 0.0f };
+        vel = { 0.0f, 1.0f };
+    }
+
+    static Vector2 Exact(double t)
+    {
+        return { (float)cos(t), (float)sin(t) };
+    }
+
+    static double Energy(Vector2 pos, Vector2 vel)
+    {
+        return 0.5 * LengthSqr(vel) - 1.0 / Length(pos);
+    }
+
+    Vector2 operator()(const Vector2& pos, const Vector2& vel) const
+    {
+        float r2 = LengthSqr(pos);
+        return pos * (-1.0f / (r2 * sqrtf(r2)));
+    }
+};
+
+struct Spring
+{
+    static const char* Name() { return "spring"; }
+
+    // k = 1, m = 1 -> x = cos(t)
+    static void Initial(Vector2& pos, Vector2& vel)
+    {
+        pos = { 1.0f, 0.0f };
+        vel = { 0.0f, 0.0f };
+    }
+
+    static Vector2 Exact(double t)
+    {
+        return { (float)cos(t), 0.0f };
+    }
+
+    static double Energy(Vector2 pos, Vector2 vel)
+    {
+        return 0.5 * LengthSqr(vel) + 0.5 * LengthSqr(pos);
+    }
+
+    Vector2 operator()(const Vector2& pos, const Vector2& vel) const
+    {
+        return Negate(pos);
+    }
+};
+
+template<typename Integrator, typename Problem>
+void Run(const char* integratorName, float dt)
+{
+    const double duration = 10.0 * 2.0 * PI;    // 10 orbits / oscillations
+    const int steps = (int)(duration / dt);
+    const int bodyCount = 4096;
+
+    Problem problem;
+    PhysicsWorld<Integrator> world;
+    for (int i = 0; i < bodyCount; i++)
+    {
+        Vector2 pos, vel;
+        Problem::Initial(pos, vel);
+        AddBody(world, pos, vel);
+    }
+    const double energy0 = Problem::Energy(world.positions[0], world.bodies[0].vel);
+
+    BenchTimer timer;
+    double maxError = 0.0;
+    for (int step = 1; step <= steps; step++)
+    {
+        Step(world, dt, problem);
+        maxError = fmax(maxError, Distance(world.positions[0], Problem::Exact(step * (double)dt)));
+    }
+    const double seconds = timer.Seconds();
+
+    const double energyDrift = fabs(Problem::Energy(world.positions[0], world.bodies[0].vel) - energy0) / fabs(energy0);
+    const bool accurate = std::isfinite(maxError) && maxError < 0.1;
+    Consume(world.positions[bodyCount - 1].x);
+
+    printf("%-8s %-20s dt=%-7.4f max error %-12.3e energy drift %-12.3e %7.2f ns/body-step %s\n",
+        Problem::Name(), integratorName, dt, maxError, energyDrift,
+        seconds * 1e9 / ((double)steps * bodyCount), accurate ? "" : "INACCURATE");
+}
+
+template<typename Problem>
+void RunAll(float dt)
+{
+    Run<SemiImplicitEuler, Problem>("SemiImplicitEuler", dt);
+    Run<VelocityVerlet, Problem>("VelocityVerlet", dt);
+    Run<PositionVerlet, Problem>("PositionVerlet", dt);
+    Run<RK4, Problem>("RK4", dt);
+}
+
+int main()
+{
+    const float timesteps[] = { 1.0f / 240.0f, 1.0f / 60.0f, 1.0f / 30.0f, 0.1f, 0.25f };
+    for (float dt : timesteps)
+    {
+        RunAll<Orbit>(dt);
+        RunAll<Spring>(dt);
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,505 @@
+#include "Bench.h"
+#include "Reference.h"
+#include "Math.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+// Speed and accuracy of the Math.h families (Vector2, Vector3, Matrix, Quaternion) on large arrays.
+// Every case is timed warm, on a small array that stays in L1 and is reused, and cold, streaming
+// through --cold-mb of inputs and outputs so each pass misses the caches. Accuracy is the largest
+// error against a double precision reference over random inputs, relative to the largest
+// component of the reference result. --json writes the table so runs can be compared across
+// commits, compilers and --simd backends.
+
+const int warmCount = 1024;
+const int accuracySamples = 100000;
+
+template<typename A, typename B>
+struct Args2
+{
+    A a;
+    B b;
+};
+
+template<typename A, typename B, typename C>
+struct Args3
+{
+    A a;
+    B b;
+    C c;
+};
+
+struct Result
+{
+    const char* family;
+    const char* name;
+    double warmNs;
+    double coldNs;
+    double maxError;
+};
+
+std::vector<Result> results;
+size_t coldBytes = 256u << 20;
+
+// ns per element of kernel over count elements, after one untimed pass
+template<typename In, typename Out, typename Kernel>
+double TimeKernel(const In* in, Out* out, int count, Kernel kernel)
+{
+    kernel(in, out, count);
+    BenchTimer timer;
+    int passes = 0;
+    do
+    {
+        kernel(in, out, count);
+        Consume(*(const float*)&out[count - 1]);
+        passes++;
+    } while (timer.Seconds() < 0.2 || passes < 2);
+    return timer.Seconds() * 1e9 / ((double)passes * count);
+}
+
+// Times kernel warm and cold, then compares it against reference on fresh random inputs
+// kernel(const In*, Out*, count) fills out; reference(const In&, double*) writes one result as doubles
+template<typename In, typename Out, typename Generate, typename Kernel, typename Reference>
+void Run(const char* family, const char* name, Generate generate, Kernel kernel, Reference reference)
+{
+    const int components = sizeof(Out) / sizeof(float);
+
+    // Inputs are generated once and tiled over the cold arrays; repeats don't help the caches
+    std::vector<In> samples(accuracySamples);
+    for (In& sample : samples) sample = generate();
+    std::vector<Out> outputs(accuracySamples);
+
+    const double warmNs = TimeKernel(samples.data(), outputs.data(), warmCount, kernel);
+
+    const int coldCount = std::max(warmCount, (int)(coldBytes / (sizeof(In) + sizeof(Out))));
+    double coldNs = 0.0;
+    {
+        std::vector<In> coldInputs(coldCount);
+        std::vector<Out> coldOutputs(coldCount);
+        for (int i = 0; i < coldCount; i += accuracySamples)
+            memcpy(&coldInputs[i], samples.data(), std::min(accuracySamples, coldCount - i) * sizeof(In));
+        coldNs = TimeKernel(coldInputs.data(), coldOutputs.data(), coldCount, kernel);
+    }
+
+    kernel(samples.data(), outputs.data(), accuracySamples);
+    double maxError = 0.0;
+    for (int i = 0; i < accuracySamples; i++)
+    {
+        double expected[16];
+        reference(samples[i], expected);
+        const float* actual = (const float*)&outputs[i];
+
+        double error = 0.0, scale = 0.0;
+        for (int k = 0; k < components; k++)
+        {
+            error = std::max(error, fabs(actual[k] - expected[k]));
+            scale = std::max(scale, fabs(expected[k]));
+        }
+        if (scale > 0.0) error /= scale;
+        maxError = std::max(maxError, error);
+    }
+
+    results.push_back({ family, name, warmNs, coldNs, maxError });
+    printf("%-10s %-24s %9.3f %9.3f %11.2e\n", family, name, warmNs, coldNs, maxError);
+}
+
+Vector2 RandomVector2()
+{
+    return { RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f) };
+}
+
+Vector3 RandomVector3()
+{
+    return { RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f) };
+}
+
+Quaternion RandomQuaternion()
+{
+    return Normalize(Vector4{ RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f) });
+}
+
+// Scale, rotation and translation, the kind of matrix a scene graph holds
+Matrix RandomTransform()
+{
+    const Vector3 axis = Normalize(Vector3{ RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f) });
+    const Matrix rotation = Rotate(axis, RandomFloat(-PI, PI));
+    const Matrix scale = Scale(RandomFloat(0.1f, 10.0f), RandomFloat(0.1f, 10.0f), RandomFloat(0.1f, 10.0f));
+    const Matrix translation = Translate(RandomFloat(-1000.0f, 1000.0f), RandomFloat(-1000.0f, 1000.0f), RandomFloat(-1000.0f, 1000.0f));
+    return Multiply(Multiply(scale, rotation), translation);
+}
+
+// Matrix elements as doubles in memory order
+void ToDouble(const Matrix& mat, double m[16])
+{
+    const float* f = &mat.m0;
+    for (int i = 0; i < 16; i++) m[i] = f[i];
+}
+
+// Point transform, x' = m0 * x + m4 * y + m8 * z + m12 and so on
+void ReferenceTransform(const Matrix& mat, double x, double y, double z, double* out, int components)
+{
+    double m[16];
+    ToDouble(mat, m);
+    for (int r = 0; r < components; r++) out[r] = m[4 * r] * x + m[4 * r + 1] * y + m[4 * r + 2] * z + m[4 * r + 3];
+}
+
+void ReferenceMultiply(const Matrix& left, const Matrix& right, double* out)
+{
+    double l[16], r[16];
+    ToDouble(left, l);
+    ToDouble(right, r);
+    for (int j = 0; j < 4; j++)
+        for (int i = 0; i < 4; i++)
+            out[4 * j + i] = l[i] * r[4 * j] + l[4 + i] * r[4 * j + 1] + l[8 + i] * r[4 * j + 2] + l[12 + i] * r[4 * j + 3];
+}
+
+// Hamilton product in the Vector4 layout (x, y, z, w)
+void ReferenceQuaternionMultiply(const double a[4], const double b[4], double* out)
+{
+    out[0] = a[0] * b[3] + a[3] * b[0] + a[1] * b[2] - a[2] * b[1];
+    out[1] = a[1] * b[3] + a[3] * b[1] + a[2] * b[0] - a[0] * b[2];
+    out[2] = a[2] * b[3] + a[3] * b[2] + a[0] * b[1] - a[1] * b[0];
+    out[3] = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+}
+
+void ReferenceNormalize(double* v, int components)
+{
+    double length = 0.0;
+    for (int k = 0; k < components; k++) length += v[k] * v[k];
+    length = sqrt(length);
+    if (length == 0.0) return;
+    for (int k = 0; k < components; k++) v[k] /= length;
+}
+
+// True slerp along the shorter arc, the result Slerp approximates with Nlerp for close inputs
+void ReferenceSlerp(Quaternion q1, Quaternion q2, float amount, double* out)
+{
+    const double a[4] = { q1.x, q1.y, q1.z, q1.w };
+    double b[4] = { q2.x, q2.y, q2.z, q2.w };
+    double cosTheta = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+    if (cosTheta < 0.0)
+    {
+        for (double& v : b) v = -v;
+        cosTheta = -cosTheta;
+    }
+
+    double ratioA = 1.0 - amount, ratioB = amount;
+    if (cosTheta < 1.0)
+    {
+        const double theta = acos(cosTheta);
+        ratioA = sin((1.0 - amount) * theta) / sin(theta);
+        ratioB = sin(amount * theta) / sin(theta);
+    }
+    for (int k = 0; k < 4; k++) out[k] = a[k] * ratioA + b[k] * ratioB;
+}
+
+void RunVector2()
+{
+    typedef Args2<Vector2, Vector2> Pair;
+    typedef Args2<Vector2, float> WithAngle;
+
+    Run<Pair, Vector2>("Vector2", "Add",
+        [] { return Pair{ RandomVector2(), RandomVector2() }; },
+        [](const Pair* in, Vector2* out, int n) { for (int i = 0; i < n; i++) out[i] = Add(in[i].a, in[i].b); },
+        [](const Pair& in, double* r) { r[0] = (double)in.a.x + in.b.x; r[1] = (double)in.a.y + in.b.y; });
+
+    Run<Vector2, float>("Vector2", "Length",
+        [] { return RandomVector2(); },
+        [](const Vector2* in, float* out, int n) { for (int i = 0; i < n; i++) out[i] = Length(in[i]); },
+        [](const Vector2& in, double* r) { r[0] = sqrt((double)in.x * in.x + (double)in.y * in.y); });
+
+    Run<Pair, float>("Vector2", "Distance",
+        [] { return Pair{ RandomVector2(), RandomVector2() }; },
+        [](const Pair* in, float* out, int n) { for (int i = 0; i < n; i++) out[i] = Distance(in[i].a, in[i].b); },
+        [](const Pair& in, double* r) { r[0] = hypot((double)in.a.x - in.b.x, (double)in.a.y - in.b.y); });
+
+    Run<Vector2, Vector2>("Vector2", "Normalize",
+        [] { return RandomVector2(); },
+        [](const Vector2* in, Vector2* out, int n) { for (int i = 0; i < n; i++) out[i] = Normalize(in[i]); },
+        [](const Vector2& in, double* r) { r[0] = in.x; r[1] = in.y; ReferenceNormalize(r, 2); });
+
+    Run<Vector2, Vector2>("Vector2", "Normalize<Fastest>",
+        [] { return RandomVector2(); },
+        [](const Vector2* in, Vector2* out, int n) { for (int i = 0; i < n; i++) out[i] = Normalize<Precision::Fastest>(in[i]); },
+        [](const Vector2& in, double* r) { r[0] = in.x; r[1] = in.y; ReferenceNormalize(r, 2); });
+
+    Run<WithAngle, Vector2>("Vector2", "Rotate",
+        [] { return WithAngle{ RandomVector2(), RandomFloat(-PI, PI) }; },
+        [](const WithAngle* in, Vector2* out, int n) { for (int i = 0; i < n; i++) out[i] = Rotate(in[i].a, in[i].b); },
+        [](const WithAngle& in, double* r)
+        {
+            const double c = cos((double)in.b), s = sin((double)in.b);
+            r[0] = in.a.x * c - in.a.y * s;
+            r[1] = in.a.x * s + in.a.y * c;
+        });
+
+    Run<WithAngle, Vector2>("Vector2", "Rotate<Fast>",
+        [] { return WithAngle{ RandomVector2(), RandomFloat(-PI, PI) }; },
+        [](const WithAngle* in, Vector2* out, int n) { for (int i = 0; i < n; i++) out[i] = Rotate<Precision::Fast>(in[i].a, in[i].b); },
+        [](const WithAngle& in, double* r)
+        {
+            const double c = cos((double)in.b), s = sin((double)in.b);
+            r[0] = in.a.x * c - in.a.y * s;
+            r[1] = in.a.x * s + in.a.y * c;
+        });
+
+    // One transform for every point, as when moving a mesh or a batch of sprites
+    static const Matrix transform = Multiply(Multiply(Scale(2.0f, 3.0f, 1.0f), RotateZ(0.7f)), Translate(10.0f, -20.0f, 0.0f));
+    static const Affine2 affine = ToAffine2(transform);
+
+    Run<Vector2, Vector2>("Vector2", "Multiply(Matrix)",
+        [] { return RandomVector2(); },
+        [](const Vector2* in, Vector2* out, int n) { for (int i = 0; i < n; i++) out[i] = Multiply(in[i], transform); },
+        [](const Vector2& in, double* r) { ReferenceTransform(transform, in.x, in.y, 0.0, r, 2); });
+
+    Run<Vector2, Vector2>("Vector2", "TransformPoints(Matrix)",
+        [] { return RandomVector2(); },
+        [](const Vector2* in, Vector2* out, int n) { TransformPoints(in, out, n, transform); },
+        [](const Vector2& in, double* r) { ReferenceTransform(transform, in.x, in.y, 0.0, r, 2); });
+
+    Run<Vector2, Vector2>("Vector2", "TransformPoints(Affine2)",
+        [] { return RandomVector2(); },
+        [](const Vector2* in, Vector2* out, int n) { TransformPoints(in, out, n, affine); },
+        [](const Vector2& in, double* r) { ReferenceTransform(transform, in.x, in.y, 0.0, r, 2); });
+}
+
+void RunVector3()
+{
+    typedef Args2<Vector3, Vector3> Pair;
+    typedef Args2<Vector3, Quaternion> WithRotation;
+
+    Run<Pair, Vector3>("Vector3", "Add",
+        [] { return Pair{ RandomVector3(), RandomVector3() }; },
+        [](const Pair* in, Vector3* out, int n) { for (int i = 0; i < n; i++) out[i] = Add(in[i].a, in[i].b); },
+        [](const Pair& in, double* r) { r[0] = (double)in.a.x + in.b.x; r[1] = (double)in.a.y + in.b.y; r[2] = (double)in.a.z + in.b.z; });
+
+    Run<Pair, Vector3>("Vector3", "Cross",
+        [] { return Pair{ RandomVector3(), RandomVector3() }; },
+        [](const Pair* in, Vector3* out, int n) { for (int i = 0; i < n; i++) out[i] = Cross(in[i].a, in[i].b); },
+        [](const Pair& in, double* r)
+        {
+            r[0] = (double)in.a.y * in.b.z - (double)in.a.z * in.b.y;
+            r[1] = (double)in.a.z * in.b.x - (double)in.a.x * in.b.z;
+            r[2] = (double)in.a.x * in.b.y - (double)in.a.y * in.b.x;
+        });
+
+    Run<Vector3, float>("Vector3", "Length",
+        [] { return RandomVector3(); },
+        [](const Vector3* in, float* out, int n) { for (int i = 0; i < n; i++) out[i] = Length(in[i]); },
+        [](const Vector3& in, double* r) { r[0] = sqrt((double)in.x * in.x + (double)in.y * in.y + (double)in.z * in.z); });
+
+    Run<Vector3, Vector3>("Vector3", "Normalize",
+        [] { return RandomVector3(); },
+        [](const Vector3* in, Vector3* out, int n) { for (int i = 0; i < n; i++) out[i] = Normalize(in[i]); },
+        [](const Vector3& in, double* r) { r[0] = in.x; r[1] = in.y; r[2] = in.z; ReferenceNormalize(r, 3); });
+
+    static const Matrix transform = RandomTransform();
+
+    Run<Vector3, Vector3>("Vector3", "Multiply(Matrix)",
+        [] { return RandomVector3(); },
+        [](const Vector3* in, Vector3* out, int n) { for (int i = 0; i < n; i++) out[i] = Multiply(in[i], transform); },
+        [](const Vector3& in, double* r) { ReferenceTransform(transform, in.x, in.y, in.z, r, 3); });
+
+    Run<Vector3, Vector3>("Vector3", "TransformPoints(Matrix)",
+        [] { return RandomVector3(); },
+        [](const Vector3* in, Vector3* out, int n) { TransformPoints(in, out, n, transform); },
+        [](const Vector3& in, double* r) { ReferenceTransform(transform, in.x, in.y, in.z, r, 3); });
+
+    Run<WithRotation, Vector3>("Vector3", "Rotate(Quaternion)",
+        [] { return WithRotation{ RandomVector3(), RandomQuaternion() }; },
+        [](const WithRotation* in, Vector3* out, int n) { for (int i = 0; i < n; i++) out[i] = Rotate(in[i].a, in[i].b); },
+        [](const WithRotation& in, double* r)
+        {
+            // q v q*
+            const double q[4] = { in.b.x, in.b.y, in.b.z, in.b.w };
+            const double v[4] = { in.a.x, in.a.y, in.a.z, 0.0 };
+            const double conjugate[4] = { -q[0], -q[1], -q[2], q[3] };
+            double qv[4], result[4];
+            ReferenceQuaternionMultiply(q, v, qv);
+            ReferenceQuaternionMultiply(qv, conjugate, result);
+            r[0] = result[0]; r[1] = result[1]; r[2] = result[2];
+        });
+}
+
+void RunMatrix()
+{
+    typedef Args2<Matrix, Matrix> Pair;
+
+    Run<Pair, Matrix>("Matrix", "Multiply",
+        [] { return Pair{ RandomTransform(), RandomTransform() }; },
+        [](const Pair* in, Matrix* out, int n) { for (int i = 0; i < n; i++) out[i] = Multiply(in[i].a, in[i].b); },
+        [](const Pair& in, double* r) { ReferenceMultiply(in.a, in.b, r); });
+
+    Run<Matrix, Matrix>("Matrix", "Transpose",
+        [] { return RandomTransform(); },
+        [](const Matrix* in, Matrix* out, int n) { for (int i = 0; i < n; i++) out[i] = Transpose(in[i]); },
+        [](const Matrix& in, double* r)
+        {
+            double m[16];
+            ToDouble(in, m);
+            for (int i = 0; i < 4; i++)
+                for (int j = 0; j < 4; j++) r[4 * i + j] = m[4 * j + i];
+        });
+
+    Run<Matrix, Matrix>("Matrix", "Invert",
+        [] { return RandomTransform(); },
+        [](const Matrix* in, Matrix* out, int n) { for (int i = 0; i < n; i++) out[i] = Invert(in[i]); },
+        [](const Matrix& in, double* r) { ReferenceInvert(in, r); });
+
+    Run<Matrix, Matrix>("Matrix", "Invert<Fast>",
+        [] { return RandomTransform(); },
+        [](const Matrix* in, Matrix* out, int n) { for (int i = 0; i < n; i++) out[i] = Invert<Precision::Fast>(in[i]); },
+        [](const Matrix& in, double* r) { ReferenceInvert(in, r); });
+
+    Run<Matrix, float>("Matrix", "Determinant",
+        [] { return RandomTransform(); },
+        [](const Matrix* in, float* out, int n) { for (int i = 0; i < n; i++) out[i] = Determinant(in[i]); },
+        [](const Matrix& in, double* r) { double inverse[16]; r[0] = ReferenceInvert(in, inverse); });
+
+    Run<Matrix, float>("Matrix", "Determinant<Fast>",
+        [] { return RandomTransform(); },
+        [](const Matrix* in, float* out, int n) { for (int i = 0; i < n; i++) out[i] = Determinant<Precision::Fast>(in[i]); },
+        [](const Matrix& in, double* r) { double inverse[16]; r[0] = ReferenceInvert(in, inverse); });
+}
+
+void RunQuaternion()
+{
+    typedef Args2<Quaternion, Quaternion> Pair;
+    typedef Args3<Quaternion, Quaternion, float> Blend;
+
+    Run<Pair, Quaternion>("Quaternion", "Multiply",
+        [] { return Pair{ RandomQuaternion(), RandomQuaternion() }; },
+        [](const Pair* in, Quaternion* out, int n) { for (int i = 0; i < n; i++) out[i] = Multiply(in[i].a, in[i].b); },
+        [](const Pair& in, double* r)
+        {
+            const double a[4] = { in.a.x, in.a.y, in.a.z, in.a.w };
+            const double b[4] = { in.b.x, in.b.y, in.b.z, in.b.w };
+            ReferenceQuaternionMultiply(a, b, r);
+        });
+
+    Run<Quaternion, Quaternion>("Quaternion", "Normalize",
+        [] { return Scale(RandomQuaternion(), RandomFloat(0.5f, 2.0f)); },
+        [](const Quaternion* in, Quaternion* out, int n) { for (int i = 0; i < n; i++) out[i] = Normalize(in[i]); },
+        [](const Quaternion& in, double* r) { r[0] = in.x; r[1] = in.y; r[2] = in.z; r[3] = in.w; ReferenceNormalize(r, 4); });
+
+    Run<Quaternion, Matrix>("Quaternion", "ToMatrix",
+        [] { return RandomQuaternion(); },
+        [](const Quaternion* in, Matrix* out, int n) { for (int i = 0; i < n; i++) out[i] = ToMatrix(in[i]); },
+        [](const Quaternion& in, double* r)
+        {
+            // Columns are the rotated basis vectors
+            const double q[4] = { in.x, in.y, in.z, in.w };
+            const double conjugate[4] = { -q[0], -q[1], -q[2], q[3] };
+            for (int k = 0; k < 16; k++) r[k] = (k == 15) ? 1.0 : 0.0;
+            for (int axis = 0; axis < 3; axis++)
+            {
+                double v[4] = { 0.0, 0.0, 0.0, 0.0 }, qv[4], rotated[4];
+                v[axis] = 1.0;
+                ReferenceQuaternionMultiply(q, v, qv);
+                ReferenceQuaternionMultiply(qv, conjugate, rotated);
+                for (int row = 0; row < 3; row++) r[4 * row + axis] = rotated[row];
+            }
+        });
+
+    Run<Blend, Quaternion>("Quaternion", "Nlerp",
+        [] { return Blend{ RandomQuaternion(), RandomQuaternion(), RandomFloat(0.0f, 1.0f) }; },
+        [](const Blend* in, Quaternion* out, int n) { for (int i = 0; i < n; i++) out[i] = Nlerp(in[i].a, in[i].b, in[i].c); },
+        [](const Blend& in, double* r)
+        {
+            const double a[4] = { in.a.x, in.a.y, in.a.z, in.a.w };
+            const double b[4] = { in.b.x, in.b.y, in.b.z, in.b.w };
+            for (int k = 0; k < 4; k++) r[k] = a[k] + in.c * (b[k] - a[k]);
+            ReferenceNormalize(r, 4);
+        });
+
+    Run<Blend, Quaternion>("Quaternion", "Slerp",
+        [] { return Blend{ RandomQuaternion(), RandomQuaternion(), RandomFloat(0.0f, 1.0f) }; },
+        [](const Blend* in, Quaternion* out, int n) { for (int i = 0; i < n; i++) out[i] = Slerp(in[i].a, in[i].b, in[i].c); },
+        [](const Blend& in, double* r) { ReferenceSlerp(in.a, in.b, in.c, r); });
+
+    Run<Blend, Quaternion>("Quaternion", "Slerp<Fast>",
+        [] { return Blend{ RandomQuaternion(), RandomQuaternion(), RandomFloat(0.0f, 1.0f) }; },
+        [](const Blend* in, Quaternion* out, int n) { for (int i = 0; i < n; i++) out[i] = Slerp<Precision::Fast>(in[i].a, in[i].b, in[i].c); },
+        [](const Blend& in, double* r) { ReferenceSlerp(in.a, in.b, in.c, r); });
+}
+
+const char* Backend()
+{
+#if defined(RM_SIMD_AVX2)
+    return "SSE4.1, VEX-encoded (avx2)";
+#elif RM_SIMD
+    return "SSE4.1";
+#else
+    return "scalar";
+#endif
+}
+
+const char* Compiler()
+{
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    static char version[32];
+    snprintf(version, sizeof(version), "msvc %d", _MSC_FULL_VER);
+    return version;
+#else
+    return "unknown";
+#endif
+}
+
+bool WriteJson(const char* path)
+{
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) return false;
+
+    fprintf(file, "{\n  \"benchmark\": \"math\",\n  \"compiler\": \"%s\",\n  \"backend\": \"%s\",\n", Compiler(), Backend());
+    fprintf(file, "  \"cold_mb\": %zu,\n  \"results\": [\n", coldBytes >> 20);
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const Result& r = results[i];
+        fprintf(file, "    { \"family\": \"%s\", \"name\": \"%s\", \"warm_ns\": %.4f, \"cold_ns\": %.4f, \"max_error\": %.3e }%s\n",
+            r.family, r.name, r.warmNs, r.coldNs, r.maxError, i + 1 < results.size() ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+
+    return fclose(file) == 0;
+}
+
+int main(int argc, char** argv)
+{
+    const char* jsonPath = nullptr;
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (hasValue && strcmp(argv[i], "--json") == 0) jsonPath = argv[++i];
+        else if (hasValue && strcmp(argv[i], "--cold-mb") == 0) coldBytes = (size_t)atoi(argv[++i]) << 20;
+        else
+        {
+            printf("usage: %s [--json path] [--cold-mb N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("backend %s, %s\n\n", Backend(), Compiler());
+    printf("%-10s %-24s %9s %9s %11s\n", "family", "ns/element", "warm", "cold", "max error");
+
+    srand(1);
+    RunVector2();
+    RunVector3();
+    RunMatrix();
+    RunQuaternion();
+
+    if (jsonPath != nullptr && !WriteJson(jsonPath))
+    {
+        printf("failed to write %s\n", jsonPath);
+        return 1;
+    }
+
+    return 0;
+}
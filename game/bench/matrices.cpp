@@ -0,0 +1,207 @@
+#include "Bench.h"
+#include "Reference.h"
+#include "Math.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+// Fuzzes the opt-in SIMD matrix multiply, inverse, determinant and batched slerp against the scalar
+// code and times both. Multiply and SlerpQuaternions must match their scalar counterparts bit
+// for bit; the Fast inverse, determinant and slerp are checked against double precision
+// references and must stay within the bounds documented in Math.h. Exits with 1 on any failure.
+// Build with --simd=none, sse4 or avx2 (the SSE4.1 code VEX-encoded) to compare backends.
+
+// out[4j + i] = sum over k of left[4k + i] * right[4j + k], summed in the order Multiply uses
+Matrix ReferenceMultiply(const Matrix& left, const Matrix& right)
+{
+    const float* l = &left.m0;
+    const float* r = &right.m0;
+    Matrix result;
+    float* o = &result.m0;
+    for (int j = 0; j < 4; j++)
+        for (int i = 0; i < 4; i++)
+            o[4 * j + i] = l[i] * r[4 * j] + l[4 + i] * r[4 * j + 1] + l[8 + i] * r[4 * j + 2] + l[12 + i] * r[4 * j + 3];
+    return result;
+}
+
+// The opt-in SIMD multiply where the backend has one, so the SIMD column has something to time
+Matrix MultiplySimd(const Matrix& left, const Matrix& right)
+{
+#if RM_SIMD
+    return MultiplyMatrixSimd(left, right);
+#else
+    return Multiply(left, right);
+#endif
+}
+
+// Largest element error relative to the largest element of the reference
+double MatrixError(const Matrix& mat, const double reference[16])
+{
+    const float* m = &mat.m0;
+    double error = 0.0, scale = 0.0;
+    for (int i = 0; i < 16; i++)
+    {
+        error = std::max(error, fabs(m[i] - reference[i]));
+        scale = std::max(scale, fabs(reference[i]));
+    }
+    return error / scale;
+}
+
+double QuaternionError(Quaternion a, Quaternion b)
+{
+    return std::max(std::max(fabs(a.x - b.x), fabs(a.y - b.y)), std::max(fabs(a.z - b.z), fabs(a.w - b.w)));
+}
+
+// Scene-graph style transforms: rotation, non-uniform scale and translation, plus diagonally
+// dominant general matrices, so every sample is reasonably conditioned
+Matrix RandomMatrix(int i)
+{
+    if (i % 2 == 0)
+    {
+        const Vector3 axis = Normalize(Vector3{ RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f) });
+        const Matrix rotation = Rotate(axis, RandomFloat(-PI, PI));
+        const Matrix scale = Scale(RandomFloat(0.1f, 10.0f), RandomFloat(0.1f, 10.0f), RandomFloat(0.1f, 10.0f));
+        const Matrix translation = Translate(RandomFloat(-1000.0f, 1000.0f), RandomFloat(-1000.0f, 1000.0f), RandomFloat(-1000.0f, 1000.0f));
+        return Multiply(Multiply(scale, rotation), translation);
+    }
+
+    Matrix result;
+    float* m = &result.m0;
+    for (int k = 0; k < 16; k++) m[k] = RandomFloat(-1.0f, 1.0f) + ((k % 5 == 0) ? 4.0f : 0.0f);
+    return result;
+}
+
+Quaternion RandomQuaternion()
+{
+    return Normalize(Vector4{ RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f), RandomFloat(-1.0f, 1.0f) });
+}
+
+// Half the pairs are close together so the Nlerp and identical-input branches are exercised
+Quaternion RandomNeighbour(Quaternion q, int i)
+{
+    switch (i % 4)
+    {
+    case 0: return q;
+    case 1: return Normalize(q + Vector4{ RandomFloat(-0.1f, 0.1f), RandomFloat(-0.1f, 0.1f), RandomFloat(-0.1f, 0.1f), RandomFloat(-0.1f, 0.1f) });
+    default: return RandomQuaternion();
+    }
+}
+
+bool Report(const char* name, double error, double bound)
+{
+    const bool pass = error <= bound;
+    printf("%-18s max error %9.2e (bound %.0e)%s\n", name, error, bound, pass ? "" : "  FAILED");
+    return pass;
+}
+
+bool ReportMismatches(const char* name, int mismatches)
+{
+    printf("%-18s %d mismatches%s\n", name, mismatches, mismatches == 0 ? "" : "  FAILED");
+    return mismatches == 0;
+}
+
+bool CheckEquivalence(int samples)
+{
+    int multiplyMismatches = 0;
+    double invertExact = 0.0, invertFast = 0.0, determinantExact = 0.0, determinantFast = 0.0, slerpFast = 0.0, slerpFastest = 0.0;
+    for (int i = 0; i < samples; i++)
+    {
+        const Matrix a = RandomMatrix(i);
+        const Matrix b = RandomMatrix(i + 1);
+        const Matrix product = Multiply(a, b);
+        const Matrix simdProduct = MultiplySimd(a, b);
+        const Matrix reference = ReferenceMultiply(a, b);
+        multiplyMismatches += memcmp(&product, &reference, sizeof(Matrix)) != 0;
+        multiplyMismatches += memcmp(&simdProduct, &reference, sizeof(Matrix)) != 0;
+
+        double inverse[16];
+        const double det = ReferenceInvert(a, inverse);
+        invertExact = std::max(invertExact, MatrixError(Invert<Precision::Exact>(a), inverse));
+        invertFast = std::max(invertFast, MatrixError(Invert<Precision::Fast>(a), inverse));
+        determinantExact = std::max(determinantExact, fabs((Determinant<Precision::Exact>(a) - det) / det));
+        determinantFast = std::max(determinantFast, fabs((Determinant<Precision::Fast>(a) - det) / det));
+
+        const Quaternion q1 = RandomQuaternion();
+        const Quaternion q2 = RandomNeighbour(q1, i);
+        const float t = RandomFloat(0.0f, 1.0f);
+        const Quaternion exact = Slerp<Precision::Exact>(q1, q2, t);
+        slerpFast = std::max(slerpFast, QuaternionError(Slerp<Precision::Fast>(q1, q2, t), exact));
+        slerpFastest = std::max(slerpFastest, QuaternionError(Slerp<Precision::Fastest>(q1, q2, t), exact));
+    }
+
+    bool pass = true;
+    pass &= ReportMismatches("Multiply", multiplyMismatches);
+    pass &= Report("Invert Exact", invertExact, 1e-5);
+    pass &= Report("Invert Fast", invertFast, 1e-5);
+    pass &= Report("Determinant Exact", determinantExact, 1e-5);
+    pass &= Report("Determinant Fast", determinantFast, 1e-5);
+    pass &= Report("Slerp Fast", slerpFast, 1e-5);
+    pass &= Report("Slerp Fastest", slerpFastest, 1e-3);
+    return pass;
+}
+
+template<Precision precision>
+int CheckSlerpBatch(const std::vector<Quaternion>& q1, const std::vector<Quaternion>& q2, std::vector<Quaternion>& single, std::vector<Quaternion>& batch)
+{
+    const int count = (int)q1.size();
+    int mismatches = 0;
+    for (float t : { 0.0f, 0.25f, 0.5f, 0.9f, 1.0f })
+    {
+        for (int i = 0; i < count; i++) single[i] = Slerp<precision>(q1[i], q2[i], t);
+        SlerpQuaternions<precision>(q1.data(), q2.data(), batch.data(), count, t);
+        for (int i = 0; i < count; i++) mismatches += memcmp(&single[i], &batch[i], sizeof(Quaternion)) != 0;
+    }
+    return mismatches;
+}
+
+int main()
+{
+#if defined(RM_SIMD_AVX2)
+    printf("backend SSE4.1, VEX-encoded (avx2)\n\n");
+#elif RM_SIMD
+    printf("backend SSE4.1\n\n");
+#else
+    printf("backend scalar\n\n");
+#endif
+
+    srand(1);
+    bool pass = CheckEquivalence(1000000);
+
+    // Counts not divisible by 4 so the batch tail runs too
+    const int count = 10003;
+    std::vector<Matrix> a(count), b(count), outM(count);
+    std::vector<Quaternion> q1(count), q2(count), single(count), batch(count);
+    std::vector<float> determinants(count);
+    for (int i = 0; i < count; i++)
+    {
+        a[i] = RandomMatrix(i);
+        b[i] = RandomMatrix(i + 1);
+        q1[i] = RandomQuaternion();
+        q2[i] = RandomNeighbour(q1[i], i);
+    }
+
+    pass &= ReportMismatches("Slerp batch Fast", CheckSlerpBatch<Precision::Fast>(q1, q2, single, batch));
+    pass &= ReportMismatches("Slerp batch Fastest", CheckSlerpBatch<Precision::Fastest>(q1, q2, single, batch));
+
+    printf("\n%-18s %10s %10s\n", "ns/op", "scalar", "SIMD");
+    const double multiplyScalar = Time(count, [&] { for (int i = 0; i < count; i++) outM[i] = Multiply(a[i], b[i]); Consume(outM[count - 1].m0); });
+    const double multiply = Time(count, [&] { for (int i = 0; i < count; i++) outM[i] = MultiplySimd(a[i], b[i]); Consume(outM[count - 1].m0); });
+    printf("%-18s %10.3f %10.3f\n", "Multiply", multiplyScalar, multiply);
+
+    const double invertExact = Time(count, [&] { for (int i = 0; i < count; i++) outM[i] = Invert<Precision::Exact>(a[i]); Consume(outM[count - 1].m0); });
+    const double invertFast = Time(count, [&] { for (int i = 0; i < count; i++) outM[i] = Invert<Precision::Fast>(a[i]); Consume(outM[count - 1].m0); });
+    printf("%-18s %10.3f %10.3f\n", "Invert", invertExact, invertFast);
+
+    const double determinantExact = Time(count, [&] { for (int i = 0; i < count; i++) determinants[i] = Determinant<Precision::Exact>(a[i]); Consume(determinants[count - 1]); });
+    const double determinantFast = Time(count, [&] { for (int i = 0; i < count; i++) determinants[i] = Determinant<Precision::Fast>(a[i]); Consume(determinants[count - 1]); });
+    printf("%-18s %10.3f %10.3f\n", "Determinant", determinantExact, determinantFast);
+
+    const double slerpExact = Time(count, [&] { for (int i = 0; i < count; i++) single[i] = Slerp<Precision::Exact>(q1[i], q2[i], 0.3f); Consume(single[count - 1].x); });
+    const double slerpFast = Time(count, [&] { for (int i = 0; i < count; i++) single[i] = Slerp<Precision::Fast>(q1[i], q2[i], 0.3f); Consume(single[count - 1].x); });
+    const double slerpBatch = Time(count, [&] { SlerpQuaternions<Precision::Fast>(q1.data(), q2.data(), batch.data(), count, 0.3f); Consume(batch[count - 1].x); });
+    printf("%-18s %10.3f %10.3f  (Slerp Fast %.3f)\n", "SlerpQuaternions", slerpExact, slerpBatch, slerpFast);
+
+    return pass ? 0 : 1;
+}
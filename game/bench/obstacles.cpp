@@ -0,0 +1,76 @@
+#include "Bench.h"
+#include "LevelFile.h"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+// Loading a large obstacle file with the mapped, threaded parser against the old ifstream loop,
+// and against a binary level of the same obstacles
+// obstacles [count]  (default 10M rectangles, written to temporary files first)
+
+int main(int argc, char** argv)
+{
+    const int count = argc > 1 ? atoi(argv[1]) : 10000000;
+    const char* path = "bench_obstacles.txt";
+    const char* levelPath = "bench_obstacles.level";
+
+    {
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr)
+        {
+            printf("failed to create %s\n", path);
+            return 1;
+        }
+        for (int i = 0; i < count; i++)
+            fprintf(file, "%.1f %.1f %.1f %.1f\n", RandomFloat(0.0f, 100000.0f), RandomFloat(0.0f, 100000.0f),
+                RandomFloat(10.0f, 60.0f), RandomFloat(10.0f, 60.0f));
+        fclose(file);
+    }
+
+    BenchTimer timer;
+    std::vector<Rectangle> mapped;
+    if (!LoadObstacles(path, mapped)) return 1;
+    const double mappedSeconds = timer.Seconds();
+
+    timer.Reset();
+    std::vector<Rectangle> streamed;
+    std::ifstream inFile(path);
+    Rectangle obstacle;
+    while (inFile >> obstacle.x >> obstacle.y >> obstacle.width >> obstacle.height)
+        streamed.push_back(obstacle);
+    const double streamedSeconds = timer.Seconds();
+
+    // Text then grid build, as startup does from a text file
+    timer.Reset();
+    std::vector<Rectangle> parsed;
+    ObstacleGrid grid;
+    LoadObstacles(path, parsed);
+    BuildObstacleGrid(grid, parsed, 64.0f);
+    const double textSeconds = timer.Seconds();
+
+    if (!SaveLevel(levelPath, parsed, &grid)) return 1;
+    timer.Reset();
+    Level level;
+    if (!MapLevel(level, levelPath)) return 1;
+    const double levelMapSeconds = timer.Seconds();
+    std::vector<Rectangle> copied;
+    ObstacleGrid copiedGrid;
+    CopyLevel(level, copied, copiedGrid);
+    const double levelCopySeconds = timer.Seconds();
+    UnmapLevel(level);
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < mapped.size() && i < streamed.size(); i++)
+        mismatches += memcmp(&mapped[i], &streamed[i], sizeof(Rectangle)) != 0;
+
+    printf("%d obstacles, %u threads\n", count, std::thread::hardware_concurrency());
+    printf("mapped   %8.1f ms  %zu loaded\n", mappedSeconds * 1000.0, mapped.size());
+    printf("ifstream %8.1f ms  %zu loaded, %zu differ\n", streamedSeconds * 1000.0, streamed.size(), mismatches);
+    printf("text + grid build %8.1f ms\n", textSeconds * 1000.0);
+    printf("level map        %8.3f ms\n", levelMapSeconds * 1000.0);
+    printf("level map + copy %8.1f ms\n", levelCopySeconds * 1000.0);
+    remove(path);
+    remove(levelPath);
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include "Bench.h"
+#include "Arena.h"
+
+#include <vector>
+
+// Pool against new and delete for objects that come and go one at a time, with checks that
+// the free list hands slots back out and never goes past capacity. Exits with 1 on any failure.
+// pool [live] [capacity]  (default 10000 live objects in a pool of 16384)
+
+// About the size of a projectile plus its bookkeeping
+struct Body
+{
+    float position[2];
+    float velocity[2];
+    float life;
+    int owner;
+    int payload[10];
+
+    Body(int id) : life(1.0f), owner(id)
+    {
+        position[0] = position[1] = velocity[0] = velocity[1] = 0.0f;
+        for (int& p : payload) p = id;
+    }
+};
+
+bool Check(const char* name, bool pass)
+{
+    printf("%-28s %s\n", name, pass ? "ok" : "FAILED");
+    return pass;
+}
+
+bool InPool(const Pool<Body>& pool, const Body* body)
+{
+    const unsigned char* p = (const unsigned char*)body;
+    const unsigned char* first = (const unsigned char*)pool.slots.data();
+    return p >= first && p < first + pool.slots.size() * sizeof(pool.slots[0]);
+}
+
+bool CheckFreeList(int capacity)
+{
+    Pool<Body> pool;
+    InitPool(pool, capacity);
+    std::vector<Body*> bodies;
+    bool inside = true;
+    for (int i = 0; i < capacity; i++)
+    {
+        bodies.push_back(PoolCreate(pool, i));
+        inside &= bodies.back() != nullptr && InPool(pool, bodies.back());
+    }
+    bool pass = Check("fills every slot", inside && pool.live == capacity);
+    pass &= Check("full pool returns null", PoolCreate(pool, -1) == nullptr && pool.live == capacity);
+
+    // A destroyed slot is the next one handed out
+    bool reused = true;
+    for (int i = 0; i < 1000; i++)
+    {
+        const int index = rand() % capacity;
+        Body* freed = bodies[index];
+        PoolDestroy(pool, freed);
+        bodies[index] = PoolCreate(pool, index);
+        reused &= bodies[index] == freed && bodies[index]->owner == index;
+    }
+    pass &= Check("reuses the last freed slot", reused);
+
+    // Emptied in random order and filled again, it hands out the same slots, each once
+    for (int i = capacity - 1; i > 0; i--)
+        std::swap(bodies[i], bodies[rand() % (i + 1)]);
+    for (Body* body : bodies) PoolDestroy(pool, body);
+    pass &= Check("empties", pool.live == 0);
+    std::vector<bool> taken(capacity, false);
+    bool distinct = true;
+    for (int i = 0; i < capacity; i++)
+    {
+        Body* body = PoolCreate(pool, i);
+        const int slot = body == nullptr ? -1 : (int)(((unsigned char*)body - (unsigned char*)pool.slots.data()) / sizeof(pool.slots[0]));
+        distinct &= slot >= 0 && slot < capacity && !taken[slot];
+        if (distinct) taken[slot] = true;
+    }
+    pass &= Check("refills with distinct slots", distinct && PoolCreate(pool, -1) == nullptr);
+    return pass;
+}
+
+int main(int argc, char** argv)
+{
+    const int live = argc > 1 ? atoi(argv[1]) : 10000;
+    const int capacity = argc > 2 ? atoi(argv[2]) : 16384;
+    if (live <= 0 || live > capacity)
+    {
+        printf("live must be between 1 and capacity\n");
+        return 1;
+    }
+
+    srand(1);
+    bool pass = CheckFreeList(capacity);
+
+    // Churn: each step frees a random live object and makes a new one in its place
+    const int steps = 1000000;
+    std::vector<int> victims(steps);
+    for (int& victim : victims) victim = rand() % live;
+
+    Pool<Body> pool;
+    InitPool(pool, capacity);
+    std::vector<Body*> bodies(live);
+    for (int i = 0; i < live; i++) bodies[i] = PoolCreate(pool, i);
+    const double poolNs = Time(steps, [&] {
+        for (int i = 0; i < steps; i++)
+        {
+            Body*& body = bodies[victims[i]];
+            PoolDestroy(pool, body);
+            body = PoolCreate(pool, i);
+        }
+        Consume((float)bodies[victims[steps - 1]]->owner);
+    });
+    pass &= Check("churn stays within the pool", pool.live == live);
+
+    for (int i = 0; i < live; i++) bodies[i] = new Body(i);
+    const double heapNs = Time(steps, [&] {
+        for (int i = 0; i < steps; i++)
+        {
+            Body*& body = bodies[victims[i]];
+            delete body;
+            body = new Body(i);
+        }
+        Consume((float)bodies[victims[steps - 1]]->owner);
+    });
+    for (Body* body : bodies) delete body;
+
+    printf("\n%d live of %d, %zu-byte objects\n", live, capacity, sizeof(Body));
+    printf("%-16s %8.2f ns per destroy + create\n", "Pool", poolNs);
+    printf("%-16s %8.2f ns per delete + new\n", "new/delete", heapNs);
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+#include "Bench.h"
+#include "Math.h"
+
+#include <vector>
+#include <cmath>
+
+// Maximum error and cost of each precision policy for the primitives behind Length,
+// Normalize, Direction, Rotate, Angle, LineAngle and Slerp. Errors are against double precision
+// libm over a dense sweep of each function's useful input range; the table in Math.h
+// documents the numbers this prints.
+
+struct Sweep
+{
+    double maxError = 0.0;
+    double nsPerCall = 0.0;
+};
+
+// Largest absolute (or relative) error of f against reference over count inputs in [min, max]
+template<typename F, typename R>
+double MaxError(F f, R reference, float min, float max, int count, bool relative)
+{
+    double result = 0.0;
+    for (int i = 0; i <= count; i++)
+    {
+        const float x = min + (max - min) * ((float)i / count);
+        const double expected = reference((double)x);
+        double error = fabs((double)f(x) - expected);
+        if (relative && expected != 0.0) error /= fabs(expected);
+        if (error > result) result = error;
+    }
+    return result;
+}
+
+// ns per call of f over a fixed array of inputs, repeated for about 0.2 s
+template<typename F>
+double NsPerCall(F f, const std::vector<float>& inputs)
+{
+    BenchTimer timer;
+    long long calls = 0;
+    float sum = 0.0f;
+    do
+    {
+        for (float x : inputs) sum += f(x);
+        calls += inputs.size();
+    } while (timer.Seconds() < 0.2);
+    Consume(sum);
+    return timer.Seconds() * 1e9 / calls;
+}
+
+template<typename F, typename R>
+Sweep Measure(F f, R reference, float min, float max, bool relative)
+{
+    std::vector<float> inputs(4096);
+    for (size_t i = 0; i < inputs.size(); i++)
+        inputs[i] = min + (max - min) * ((float)i / inputs.size());
+
+    Sweep result;
+    result.maxError = MaxError(f, reference, min, max, 4000000, relative);
+    result.nsPerCall = NsPerCall(f, inputs);
+    return result;
+}
+
+template<typename F0, typename F1, typename F2, typename R>
+void Row(const char* name, F0 exact, F1 fast, F2 fastest, R reference, float min, float max, bool relative)
+{
+    const Sweep e = Measure(exact, reference, min, max, relative);
+    const Sweep f = Measure(fast, reference, min, max, relative);
+    const Sweep ff = Measure(fastest, reference, min, max, relative);
+    printf("%-9s %10.2e %7.2f   %10.2e %7.2f   %10.2e %7.2f  %s\n", name,
+        e.maxError, e.nsPerCall, f.maxError, f.nsPerCall, ff.maxError, ff.nsPerCall, relative ? "relative" : "absolute");
+}
+
+int main()
+{
+    printf("%-9s %18s   %18s   %18s\n", "", "Exact", "Fast", "Fastest");
+    printf("%-9s %10s %7s   %10s %7s   %10s %7s\n", "", "max error", "ns", "max error", "ns", "max error", "ns");
+
+    Row("Sqrt",
+        [](float x) { return Sqrt<Precision::Exact>(x); },
+        [](float x) { return Sqrt<Precision::Fast>(x); },
+        [](float x) { return Sqrt<Precision::Fastest>(x); },
+        [](double x) { return sqrt(x); }, 1e-6f, 1e6f, true);
+
+    Row("InvSqrt",
+        [](float x) { return InvSqrt<Precision::Exact>(x); },
+        [](float x) { return InvSqrt<Precision::Fast>(x); },
+        [](float x) { return InvSqrt<Precision::Fastest>(x); },
+        [](double x) { return 1.0 / sqrt(x); }, 1e-6f, 1e6f, true);
+
+    Row("Sin",
+        [](float x) { return Sin<Precision::Exact>(x); },
+        [](float x) { return Sin<Precision::Fast>(x); },
+        [](float x) { return Sin<Precision::Fastest>(x); },
+        [](double x) { return sin(x); }, -100.0f, 100.0f, false);
+
+    Row("Cos",
+        [](float x) { return Cos<Precision::Exact>(x); },
+        [](float x) { return Cos<Precision::Fast>(x); },
+        [](float x) { return Cos<Precision::Fastest>(x); },
+        [](double x) { return cos(x); }, -100.0f, 100.0f, false);
+
+    // Slerp's sin; Sin and Cos above are libm at every precision
+    Row("SinApprox",
+        [](float x) { return SinApprox<Precision::Exact>(x); },
+        [](float x) { return SinApprox<Precision::Fast>(x); },
+        [](float x) { return SinApprox<Precision::Fastest>(x); },
+        [](double x) { return sin(x); }, -100.0f, 100.0f, false);
+
+    // Atan2 sweeps the full circle of directions
+    Row("Atan2",
+        [](float t) { return Atan2<Precision::Exact>(sinf(t), cosf(t)); },
+        [](float t) { return Atan2<Precision::Fast>(sinf(t), cosf(t)); },
+        [](float t) { return Atan2<Precision::Fastest>(sinf(t), cosf(t)); },
+        [](double t) { return atan2((double)sinf((float)t), (double)cosf((float)t)); }, -3.14159f, 3.14159f, false);
+
+    Row("Acos",
+        [](float x) { return Acos<Precision::Exact>(x); },
+        [](float x) { return Acos<Precision::Fast>(x); },
+        [](float x) { return Acos<Precision::Fastest>(x); },
+        [](double x) { return acos(x); }, -1.0f, 1.0f, false);
+
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include "Bench.h"
+#include "Simulation.h"
+
+// Cost of saving and restoring a 10k body simulation every frame,
+// as rollback netcode would when resimulating after a late input
+
+int main()
+{
+    const int bodyCount = 10000;
+    const int obstacleCount = 1000;
+    const int frames = 10000;
+    const size_t historyFrames = 120;
+
+    Simulation sim;
+    for (int i = 0; i < bodyCount; i++)
+    {
+        Vector2 position{ NextFloat(sim.rng, 0.0f, 1280.0f), NextFloat(sim.rng, 0.0f, 720.0f) };
+        Vector2 velocity{ NextFloat(sim.rng, -100.0f, 100.0f), NextFloat(sim.rng, -100.0f, 100.0f) };
+        AddBody(sim.physics, position, velocity);
+    }
+    std::vector<Rectangle> obstacles;
+    for (int i = 0; i < obstacleCount; i++)
+        obstacles.push_back({ NextFloat(sim.rng, 0.0f, 1280.0f), NextFloat(sim.rng, 0.0f, 720.0f), 20.0f, 20.0f });
+    sim.obstacles = std::make_shared<const std::vector<Rectangle>>(std::move(obstacles));
+
+    SnapshotRing history;
+    InitSnapshots(history, historyFrames);
+
+    auto gravity = [](const Vector2& pos, const Vector2& vel) { return Vector2{ 0.0f, 98.0f }; };
+    const float dt = 1.0f / 60.0f;
+
+    double saveSeconds = 0.0, restoreSeconds = 0.0;
+    BenchTimer timer;
+    for (int frame = 0; frame < frames; frame++)
+    {
+        Step(sim.physics, dt, gravity);
+        sim.tick++;
+
+        timer.Reset();
+        SaveSnapshot(history, sim);
+        saveSeconds += timer.Seconds();
+
+        timer.Reset();
+        RestoreSnapshot(history, sim, frame % history.count);
+        restoreSeconds += timer.Seconds();
+    }
+    Consume(sim.physics.positions[0].x);
+
+    const double bytes = sizeof(SnapshotHeader) + bodyCount * (sizeof(Vector2) + sizeof(Rigidbody));
+    printf("%d bodies, %.1f KiB per snapshot, %zu frame history\n", bodyCount, bytes / 1024.0, historyFrames);
+    printf("save    %8.2f us/frame  %6.2f GB/s\n", saveSeconds * 1e6 / frames, bytes * frames / saveSeconds / 1e9);
+    printf("restore %8.2f us/frame  %6.2f GB/s\n", restoreSeconds * 1e6 / frames, bytes * frames / restoreSeconds / 1e9);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "Bench.h"
+#include "Steering.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// A tick of UpdateFlock for a large flock chasing a moving target around an obstacle field,
+// against the 60 Hz frame budget
+// steering [agents] [obstacles] [threads]  (default 50k agents, 2k obstacles, every hardware thread)
+
+int main(int argc, char** argv)
+{
+    const int agentCount = argc > 1 ? atoi(argv[1]) : 50000;
+    const int obstacleCount = argc > 2 ? atoi(argv[2]) : 2000;
+    const float size = 4000.0f;
+    const int ticks = 300;
+    const float dt = 1.0f / 60.0f;
+
+    SteeringParams params;
+    if (argc > 3) params.threads = atoi(argv[3]);
+
+    Flock flock;
+    for (int i = 0; i < agentCount; i++)
+        AddAgent(flock, Vector2{ RandomFloat(0.0f, size), RandomFloat(0.0f, size) },
+            Vector2{ RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f) });
+
+    std::vector<Rectangle> obstacles(obstacleCount);
+    for (Rectangle& obstacle : obstacles)
+        obstacle = Rectangle{ RandomFloat(0.0f, size), RandomFloat(0.0f, size), RandomFloat(20.0f, 120.0f), RandomFloat(20.0f, 120.0f) };
+    ObstacleGrid grid;
+    BuildObstacleGrid(grid, obstacles, 64.0f);
+
+    // The flock bunches up behind the target over the run, so later ticks cost the most
+    std::vector<double> tickSeconds;
+    tickSeconds.reserve(ticks);
+    for (int tick = 0; tick < ticks; tick++)
+    {
+        const float angle = tick * dt * 0.5f;
+        const Vector2 center{ size * 0.5f, size * 0.5f };
+        const Vector2 target = center + Vector2{ cosf(angle), sinf(angle) } * (size * 0.3f);
+        const Vector2 threat = center - Vector2{ cosf(angle), sinf(angle) } * (size * 0.2f);
+
+        BenchTimer timer;
+        UpdateFlock(flock, params, target, threat, grid, obstacles, dt);
+        tickSeconds.push_back(timer.Seconds());
+    }
+
+    float checksum = 0.0f;
+    for (int i = 0; i < AgentCount(flock); i++)
+        checksum += flock.px[i] + flock.py[i];
+    Consume(checksum);
+
+    double total = 0.0;
+    for (double seconds : tickSeconds)
+        total += seconds;
+    std::sort(tickSeconds.begin(), tickSeconds.end());
+
+    const double budget = 1000.0 / 60.0;
+    const double mean = total * 1000.0 / ticks;
+    printf("%d agents, %d obstacles, %d threads, %d ticks\n", agentCount, obstacleCount, SteeringThreads(params), ticks);
+    printf("mean    %8.3f ms per tick  (%.0f%% of the %.1f ms frame)\n", mean, mean * 100.0 / budget, budget);
+    printf("median  %8.3f ms\n", tickSeconds[ticks / 2] * 1000.0);
+    printf("worst   %8.3f ms\n", tickSeconds.back() * 1000.0);
+    return 0;
+}
@@ -0,0 +1,227 @@
+#include "Bench.h"
+#include "Math.h"
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+
+// Checks the 4-wide Math.h functions against plain scalar references on random inputs and
+// times both. Every result must match bit for bit; the report is in ulps so a backend that
+// trades accuracy for speed can be given a bound. Exits with 1 when any result is out of bounds.
+// The batch transforms are checked against their single-element functions the same way.
+// Build with --simd=none, sse4 or avx2 (the SSE4.1 code VEX-encoded) to compare backends.
+
+struct Reference
+{
+    static Vector4 Add(Vector4 a, Vector4 b) { return { a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w }; }
+    static Vector4 Subtract(Vector4 a, Vector4 b) { return { a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w }; }
+    static Vector4 Scale(Vector4 a, float s) { return { a.x * s, a.y * s, a.z * s, a.w * s }; }
+    static Vector4 Divide(Vector4 a, Vector4 b) { return { a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w }; }
+
+    static Vector4 Lerp(Vector4 a, Vector4 b, float t)
+    {
+        return { a.x + t * (b.x - a.x), a.y + t * (b.y - a.y), a.z + t * (b.z - a.z), a.w + t * (b.w - a.w) };
+    }
+
+    static float Length(Vector4 a)
+    {
+        return sqrtf(a.x * a.x + a.y * a.y + a.z * a.z + a.w * a.w);
+    }
+
+    static Vector4 Normalize(Vector4 a)
+    {
+        float length = Length(a);
+        if (length == 0.0f) length = 1.0f;
+        return Scale(a, 1.0f / length);
+    }
+
+    static Vector4 Multiply(Vector4 a, Vector4 b)
+    {
+        return {
+            a.x * b.w + a.w * b.x + a.y * b.z - a.z * b.y,
+            a.y * b.w + a.w * b.y + a.z * b.x - a.x * b.z,
+            a.z * b.w + a.w * b.z + a.x * b.y - a.y * b.x,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+        };
+    }
+};
+
+// Distance between two floats in units in the last place
+uint32_t Ulps(float a, float b)
+{
+    if (a == b) return 0;
+    int32_t ia, ib;
+    memcpy(&ia, &a, sizeof(float));
+    memcpy(&ib, &b, sizeof(float));
+    if (ia < 0) ia = INT32_MIN - ia;
+    if (ib < 0) ib = INT32_MIN - ib;
+    int64_t diff = (int64_t)ia - (int64_t)ib;
+    return (uint32_t)(diff < 0 ? -diff : diff);
+}
+
+uint32_t Ulps(Vector4 a, Vector4 b)
+{
+    uint32_t x = Ulps(a.x, b.x), y = Ulps(a.y, b.y), z = Ulps(a.z, b.z), w = Ulps(a.w, b.w);
+    uint32_t result = x > y ? x : y;
+    result = result > z ? result : z;
+    return result > w ? result : w;
+}
+
+Vector4 RandomVector4()
+{
+    return { RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f) };
+}
+
+bool Report(const char* name, uint32_t maxUlps, uint32_t bound)
+{
+    const bool pass = maxUlps <= bound;
+    printf("%-12s max %u ulp (bound %u)%s\n", name, maxUlps, bound, pass ? "" : "  FAILED");
+    return pass;
+}
+
+bool CheckEquivalence(int samples)
+{
+    uint32_t add = 0, subtract = 0, scale = 0, divide = 0, lerp = 0, length = 0, normalize = 0, nlerp = 0, multiply = 0, aligned = 0;
+    for (int i = 0; i < samples; i++)
+    {
+        const Vector4 a = RandomVector4();
+        const Vector4 b = RandomVector4();
+        const float t = RandomFloat(0.0f, 1.0f);
+
+        add = std::max(add, Ulps(Add(a, b), Reference::Add(a, b)));
+        subtract = std::max(subtract, Ulps(Subtract(a, b), Reference::Subtract(a, b)));
+        scale = std::max(scale, Ulps(Scale(a, t), Reference::Scale(a, t)));
+        divide = std::max(divide, Ulps(Divide(a, b), Reference::Divide(a, b)));
+        lerp = std::max(lerp, Ulps(Lerp(a, b, t), Reference::Lerp(a, b, t)));
+        length = std::max(length, Ulps(Length(a), Reference::Length(a)));
+        normalize = std::max(normalize, Ulps(Normalize(a), Reference::Normalize(a)));
+        nlerp = std::max(nlerp, Ulps(Nlerp(a, b, t), Reference::Normalize(Reference::Lerp(a, b, t))));
+        multiply = std::max(multiply, Ulps(Multiply(a, b), Reference::Multiply(a, b)));
+        aligned = std::max(aligned, Ulps(FromAligned(Multiply(ToAligned(a), ToAligned(b))), Reference::Multiply(a, b)));
+    }
+
+    bool pass = true;
+    pass &= Report("Add", add, 0);
+    pass &= Report("Subtract", subtract, 0);
+    pass &= Report("Scale", scale, 0);
+    pass &= Report("Divide", divide, 0);
+    pass &= Report("Lerp", lerp, 0);
+    pass &= Report("Multiply", multiply, 0);
+    pass &= Report("Multiply A", aligned, 0);
+    pass &= Report("Length", length, 0);
+    pass &= Report("Normalize", normalize, 0);
+    pass &= Report("Nlerp", nlerp, 0);
+    return pass;
+}
+
+bool Same(const void* a, const void* b, size_t size)
+{
+    return memcmp(a, b, size) == 0;
+}
+
+Matrix RandomMatrix()
+{
+    Matrix result;
+    float* m = &result.m0;
+    for (int i = 0; i < 16; i++) m[i] = RandomFloat(-2.0f, 2.0f);
+    return result;
+}
+
+int main()
+{
+#if defined(RM_SIMD_AVX2)
+    printf("backend SSE4.1, VEX-encoded (avx2)\n\n");
+#elif RM_SIMD
+    printf("backend SSE4.1\n\n");
+#else
+    printf("backend scalar\n\n");
+#endif
+
+    srand(1);
+    const bool pass = CheckEquivalence(1000000);
+
+    const int count = 4096;
+    std::vector<Vector4> a(count), b(count), out(count);
+    std::vector<Vector4A> aa(count), ba(count), outa(count);
+    for (int i = 0; i < count; i++)
+    {
+        a[i] = RandomVector4();
+        b[i] = RandomVector4();
+        aa[i] = ToAligned(a[i]);
+        ba[i] = ToAligned(b[i]);
+    }
+
+    printf("\n%-12s %10s %10s %10s\n", "ns/op", "reference", "Vector4", "Vector4A");
+    const double multiplyReference = Time(count, [&] { for (int i = 0; i < count; i++) out[i] = Reference::Multiply(a[i], b[i]); Consume(out[count - 1].x); });
+    const double multiply = Time(count, [&] { for (int i = 0; i < count; i++) out[i] = Multiply(a[i], b[i]); Consume(out[count - 1].x); });
+    const double multiplyAligned = Time(count, [&] { for (int i = 0; i < count; i++) outa[i] = Multiply(aa[i], ba[i]); Consume(outa[count - 1].x); });
+    printf("%-12s %10.3f %10.3f %10.3f\n", "Multiply", multiplyReference, multiply, multiplyAligned);
+
+    const double nlerpReference = Time(count, [&] { for (int i = 0; i < count; i++) out[i] = Reference::Normalize(Reference::Lerp(a[i], b[i], 0.3f)); Consume(out[count - 1].x); });
+    const double nlerp = Time(count, [&] { for (int i = 0; i < count; i++) out[i] = Nlerp(a[i], b[i], 0.3f); Consume(out[count - 1].x); });
+    const double nlerpAligned = Time(count, [&] { for (int i = 0; i < count; i++) outa[i] = Nlerp(aa[i], ba[i], 0.3f); Consume(outa[count - 1].x); });
+    printf("%-12s %10.3f %10.3f %10.3f\n", "Nlerp", nlerpReference, nlerp, nlerpAligned);
+
+    const double lerpReference = Time(count, [&] { for (int i = 0; i < count; i++) out[i] = Reference::Lerp(a[i], b[i], 0.3f); Consume(out[count - 1].x); });
+    const double lerp = Time(count, [&] { for (int i = 0; i < count; i++) out[i] = Lerp(a[i], b[i], 0.3f); Consume(out[count - 1].x); });
+    const double lerpAligned = Time(count, [&] { for (int i = 0; i < count; i++) outa[i] = Lerp(aa[i], ba[i], 0.3f); Consume(outa[count - 1].x); });
+    printf("%-12s %10.3f %10.3f %10.3f\n", "Lerp", lerpReference, lerp, lerpAligned);
+
+    // Batch transforms, one point set or matrix set at a time so counts not divisible by 4 hit the tail
+    const int batch = 10003;
+    std::vector<Vector3> points3(batch), single3(batch), out3(batch);
+    std::vector<Vector2> points2(batch), single2(batch), out2(batch);
+    std::vector<Quaternion> rotations(batch);
+    std::vector<Matrix> left(batch), right(batch), singleM(batch), outM(batch);
+    for (int i = 0; i < batch; i++)
+    {
+        points3[i] = { RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f), RandomFloat(-100.0f, 100.0f) };
+        points2[i] = { points3[i].x, points3[i].y };
+        rotations[i] = Normalize(RandomVector4());
+        left[i] = RandomMatrix();
+        right[i] = RandomMatrix();
+    }
+    const Matrix transform = RandomMatrix();
+
+    printf("\n%-16s %10s %10s %s\n", "ns/element", "single", "batch", "match");
+    bool batchPass = true;
+
+    const double transform3Single = Time(batch, [&] { for (int i = 0; i < batch; i++) single3[i] = Multiply(points3[i], transform); Consume(single3[batch - 1].x); });
+    const double transform3Batch = Time(batch, [&] { TransformPoints(points3.data(), out3.data(), batch, transform); Consume(out3[batch - 1].x); });
+    const bool transform3Match = Same(single3.data(), out3.data(), batch * sizeof(Vector3));
+    printf("%-16s %10.3f %10.3f %s\n", "TransformPoints3", transform3Single, transform3Batch, transform3Match ? "yes" : "NO");
+
+    const double transform2Single = Time(batch, [&] { for (int i = 0; i < batch; i++) single2[i] = Multiply(points2[i], transform); Consume(single2[batch - 1].x); });
+    const double transform2Batch = Time(batch, [&] { TransformPoints(points2.data(), out2.data(), batch, transform); Consume(out2[batch - 1].x); });
+    const bool transform2Match = Same(single2.data(), out2.data(), batch * sizeof(Vector2));
+    printf("%-16s %10.3f %10.3f %s\n", "TransformPoints2", transform2Single, transform2Batch, transform2Match ? "yes" : "NO");
+
+    // The same 2D points through the 24-byte Affine2 instead of the 64-byte Matrix
+    const Affine2 affine = ToAffine2(transform);
+    const double affineSingle = Time(batch, [&] { for (int i = 0; i < batch; i++) single2[i] = Multiply(points2[i], affine); Consume(single2[batch - 1].x); });
+    const double affineBatch = Time(batch, [&] { TransformPoints(points2.data(), out2.data(), batch, affine); Consume(out2[batch - 1].x); });
+    const bool affineMatch = Same(single2.data(), out2.data(), batch * sizeof(Vector2));
+    printf("%-16s %10.3f %10.3f %s\n", "TransformAffine", affineSingle, affineBatch, affineMatch ? "yes" : "NO");
+
+    const double matricesSingle = Time(batch, [&] { for (int i = 0; i < batch; i++) singleM[i] = Multiply(left[i], right[i]); Consume(singleM[batch - 1].m0); });
+    const double matricesBatch = Time(batch, [&] { MultiplyMatrices(left.data(), right.data(), outM.data(), batch); Consume(outM[batch - 1].m0); });
+    bool matricesMatch = Same(singleM.data(), outM.data(), batch * sizeof(Matrix));
+    printf("%-16s %10.3f %10.3f %s\n", "MultiplyMatrices", matricesSingle, matricesBatch, matricesMatch ? "yes" : "NO");
+#if RM_SIMD
+    // The opt-in SIMD product over the same batch, the alternative MultiplyMatrices passes up
+    const double matricesSimd = Time(batch, [&] { for (int i = 0; i < batch; i++) outM[i] = MultiplyMatrixSimd(left[i], right[i]); Consume(outM[batch - 1].m0); });
+    const bool matricesSimdMatch = Same(singleM.data(), outM.data(), batch * sizeof(Matrix));
+    printf("%-16s %10s %10.3f %s\n", "  SIMD per pair", "", matricesSimd, matricesSimdMatch ? "yes" : "NO");
+    matricesMatch = matricesMatch && matricesSimdMatch;
+#endif
+
+    const double rotateSingle = Time(batch, [&] { for (int i = 0; i < batch; i++) single3[i] = Rotate(points3[i], rotations[i]); Consume(single3[batch - 1].x); });
+    const double rotateBatch = Time(batch, [&] { RotateVectors(points3.data(), rotations.data(), out3.data(), batch); Consume(out3[batch - 1].x); });
+    const bool rotateMatch = Same(single3.data(), out3.data(), batch * sizeof(Vector3));
+    printf("%-16s %10.3f %10.3f %s\n", "RotateVectors", rotateSingle, rotateBatch, rotateMatch ? "yes" : "NO");
+
+    batchPass = transform3Match && transform2Match && affineMatch && matricesMatch && rotateMatch;
+    return pass && batchPass ? 0 : 1;
+}
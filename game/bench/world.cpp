@@ -0,0 +1,69 @@
+#include "Bench.h"
+#include "WorldStream.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Streaming a world around a player crossing it: stitching the active chunks' grids against
+// building a grid over the same obstacles, and memory held against the whole world's size
+// world [count] [size]  (default 4M rectangles over a 200000 square, written to a temporary file)
+
+int main(int argc, char** argv)
+{
+    const int count = argc > 1 ? atoi(argv[1]) : 4000000;
+    const float size = argc > 2 ? (float)atof(argv[2]) : 200000.0f;
+    const char* path = "bench_world.world";
+
+    {
+        std::vector<Rectangle> obstacles(count);
+        for (Rectangle& obstacle : obstacles)
+            obstacle = Rectangle{ RandomFloat(0.0f, size), RandomFloat(0.0f, size), RandomFloat(10.0f, 60.0f), RandomFloat(10.0f, 60.0f) };
+        if (!SaveWorld(path, obstacles, 1024.0f, 64.0f)) return 1;
+    }
+
+    WorldStream stream;
+    if (!StartWorldStream(stream, path, 1, 2)) return 1;
+
+    // A diagonal walk, a chunk every 8 steps, with a pause each step for the loader to read ahead
+    std::vector<Rectangle> obstacles;
+    ObstacleGrid stitched, built;
+    double updateSeconds = 0.0, stitchSeconds = 0.0, buildSeconds = 0.0;
+    int moves = 0;
+    size_t largestWindow = 0;
+    for (float t = 0.0f; t < size; t += 128.0f)
+    {
+        BenchTimer timer;
+        const bool moved = UpdateWorldStream(stream, Vector2{ t, t * 0.5f });
+        updateSeconds += timer.Seconds();
+        if (moved)
+        {
+            timer.Reset();
+            StitchWorldWindow(stream, obstacles, stitched);
+            stitchSeconds += timer.Seconds();
+
+            timer.Reset();
+            BuildObstacleGrid(built, obstacles, 64.0f);
+            buildSeconds += timer.Seconds();
+            moves++;
+            largestWindow = std::max(largestWindow, obstacles.size());
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+
+    size_t resident = 0;
+    for (const WorldSlot& slot : stream.slots)
+        resident += slot.data.capacity();
+
+    printf("%d obstacles, %dx%d chunks, %.1f MiB on disk\n", count, stream.world.header.chunksX, stream.world.header.chunksY,
+        stream.world.header.fileSize / (1024.0 * 1024.0));
+    printf("%d window moves, at most %zu obstacles in the window\n", moves, largestWindow);
+    printf("update  %8.3f ms per move  (%d read ahead, %d stalls, %d evicted)\n", updateSeconds * 1000.0 / moves,
+        stream.loads, stream.stalls, stream.evictions);
+    printf("stitch  %8.3f ms per move\n", stitchSeconds * 1000.0 / moves);
+    printf("build   %8.3f ms per move\n", buildSeconds * 1000.0 / moves);
+    printf("chunks  %8.1f MiB resident in %zu slots\n", resident / (1024.0 * 1024.0), stream.slots.size());
+    StopWorldStream(stream);
+    remove(path);
+    return 0;
+}
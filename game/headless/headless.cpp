@@ -0,0 +1,217 @@
+#include "raylib.h"
+#include "Simulation.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Runs the simulation without a window for a fixed number of ticks with scripted input,
+// then reports throughput, per-subsystem time and a checksum of the final state.
+// Two runs with the same arguments must print the same checksum.
+//
+// headless [--ticks N] [--obstacles path | --generate N] [--bodies N] [--seed N]
+//          [--trace path [--trace-ticks N]]
+// --obstacles takes a text obstacle file, or a binary level or world from levelconvert. A world is
+// streamed around the player, who sweeps its whole area instead of the screen.
+// --generate scatters N random obstacles over an area that grows with N.
+// --trace writes a Chrome trace of the first --trace-ticks ticks (default all), one frame per tick.
+
+using Clock = std::chrono::steady_clock;
+
+double Milliseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// FNV-1a over raw bytes
+uint64_t Hash(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// The player sweeps a Lissajous curve across the bounds, turning one way then the other
+// and firing in one second bursts
+PlayerInput ScriptedInput(const Simulation& sim, uint64_t tick, uint64_t ticks)
+{
+    const float t = tick / 60.0f;
+    const Rectangle& bounds = sim.bounds;
+
+    PlayerInput input;
+    input.position.x = bounds.x + bounds.width * (0.5f + 0.45f * sinf(t * 0.7f));
+    input.position.y = bounds.y + bounds.height * (0.5f + 0.45f * sinf(t * 1.1f));
+    input.rotateCW = tick < ticks / 2;
+    input.rotateCCW = !input.rotateCW && (tick / 60) % 2 == 0;
+    input.fire = (tick / 60) % 2 == 1;
+    return input;
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t ticks = 10000;
+    const char* obstaclesPath = "../game/assets/data/obstacles.txt";
+    int generatedObstacles = 0;
+    int bodyCount = 1000;
+    uint64_t seed = 1;
+    const char* tracePath = nullptr;
+    int traceTicks = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (hasValue && strcmp(argv[i], "--ticks") == 0) ticks = strtoull(argv[++i], nullptr, 10);
+        else if (hasValue && strcmp(argv[i], "--obstacles") == 0) obstaclesPath = argv[++i];
+        else if (hasValue && strcmp(argv[i], "--generate") == 0) generatedObstacles = atoi(argv[++i]);
+        else if (hasValue && strcmp(argv[i], "--bodies") == 0) bodyCount = atoi(argv[++i]);
+        else if (hasValue && strcmp(argv[i], "--seed") == 0) seed = strtoull(argv[++i], nullptr, 10);
+        else if (hasValue && strcmp(argv[i], "--trace") == 0) tracePath = argv[++i];
+        else if (hasValue && strcmp(argv[i], "--trace-ticks") == 0) traceTicks = atoi(argv[++i]);
+        else
+        {
+            printf("usage: %s [--ticks N] [--obstacles path | --generate N] [--bodies N] [--seed N] [--trace path [--trace-ticks N]]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Simulation sim;
+    WorldStream world;
+    sim.rng.state ^= seed;
+    InitProjectiles(sim.projectiles, 50000, 4096);
+    if (generatedObstacles > 0)
+    {
+        // The bounds grow to about one obstacle per 100x100 area, so large counts make a large
+        // map rather than a pile; never smaller than the default screen-sized bounds
+        const float scale = std::max(1.0f, sqrtf(generatedObstacles * 10000.0f / (sim.bounds.width * sim.bounds.height)));
+        sim.bounds.width *= scale;
+        sim.bounds.height *= scale;
+
+        std::vector<Rectangle> obstacles;
+        for (int i = 0; i < generatedObstacles; i++)
+        {
+            float width = NextFloat(sim.rng, 10.0f, 60.0f);
+            float height = NextFloat(sim.rng, 10.0f, 60.0f);
+            obstacles.push_back({ NextFloat(sim.rng, sim.bounds.x, sim.bounds.x + sim.bounds.width - width),
+                NextFloat(sim.rng, sim.bounds.y, sim.bounds.y + sim.bounds.height - height), width, height });
+        }
+        sim.obstacles = std::make_shared<const std::vector<Rectangle>>(std::move(obstacles));
+    }
+    else if (ReadFileMagic(obstaclesPath) == worldMagic)
+    {
+        if (!StartWorldStream(world, obstaclesPath, 1, 2)) return 1;
+        sim.world = &world;
+        sim.bounds = world.world.header.bounds;
+    }
+    else if (!LoadLevel(sim, obstaclesPath))
+        return 1;
+
+    for (int i = 0; i < bodyCount; i++)
+    {
+        Vector2 position{ sim.bounds.x + NextFloat(sim.rng, 0.0f, sim.bounds.width), sim.bounds.y + NextFloat(sim.rng, 0.0f, sim.bounds.height) };
+        Vector2 velocity{ NextFloat(sim.rng, -200.0f, 200.0f), NextFloat(sim.rng, -200.0f, 200.0f) };
+        AddBody(sim.physics, position, velocity);
+    }
+
+    // Fixed timestep so results don't depend on how fast the machine is
+    const float dt = 1.0f / 60.0f;
+    Clock::duration inputTime{}, gridTime{}, physicsTime{}, projectileTime{}, collisionTime{};
+    uint64_t laserHash = 14695981039346656037ull;
+    int laserHits = 0;
+    uint64_t projectileHits = 0;
+    int maxProjectiles = 0;
+
+    // Frames are only closed while tracing; otherwise the zones just cycle through the ring
+    PROFILE_THREAD("Simulation");
+    if (tracePath != nullptr)
+    {
+        PROFILE_FRAME();
+        StartTraceCapture(tracePath, traceTicks > 0 ? traceTicks : (int)ticks);
+    }
+
+    const Clock::time_point start = Clock::now();
+    for (uint64_t tick = 0; tick < ticks; tick++)
+    {
+        Clock::time_point t0 = Clock::now();
+        const PlayerInput input = ScriptedInput(sim, tick, ticks);
+        ApplyInput(sim, input, dt);
+
+        Clock::time_point t1 = Clock::now();
+        {
+            PROFILE_ZONE("Obstacle grid");
+            UpdateObstacleGrid(sim);
+        }
+
+        Clock::time_point t2 = Clock::now();
+        {
+            PROFILE_ZONE("Physics");
+            StepBodies(sim, dt);
+        }
+
+        Clock::time_point t3 = Clock::now();
+        {
+            PROFILE_ZONE("Projectiles");
+            if (input.fire)
+                FireProjectiles(sim);
+            StepProjectiles(sim.projectiles, sim.obstacleGrid, *sim.obstacles, dt);
+        }
+        projectileHits += sim.projectiles.hitCount;
+        maxProjectiles = std::max(maxProjectiles, sim.projectiles.count);
+        sim.tick++;
+
+        Clock::time_point t4 = Clock::now();
+        LaserResult laser;
+        {
+            PROFILE_ZONE("Collision queries");
+            laser = CastLaser(sim);
+        }
+        laserHits += laser.hit;
+        laserHash = Hash(laserHash, &laser.poi, sizeof(laser.poi));
+
+        Clock::time_point t5 = Clock::now();
+        inputTime += t1 - t0;
+        gridTime += t2 - t1;
+        physicsTime += t3 - t2;
+        projectileTime += t4 - t3;
+        collisionTime += t5 - t4;
+
+        if (GetProfiler().capturing)
+        {
+            PROFILE_COUNTER("Projectiles", sim.projectiles.count);
+            PROFILE_COUNTER("Hits", sim.projectiles.hitCount);
+            PROFILE_FRAME();
+        }
+    }
+    const double totalMs = Milliseconds(Clock::now() - start);
+    ProfilerShutdown();
+
+    uint64_t checksum = laserHash;
+    checksum = Hash(checksum, &sim.playerRotation, sizeof(sim.playerRotation));
+    checksum = Hash(checksum, sim.physics.positions.data(), sim.physics.positions.size() * sizeof(Vector2));
+    checksum = Hash(checksum, sim.physics.bodies.data(), sim.physics.bodies.size() * sizeof(Rigidbody));
+    checksum = Hash(checksum, &projectileHits, sizeof(projectileHits));
+    checksum = Hash(checksum, sim.projectiles.px.data(), sim.projectiles.count * sizeof(float));
+    checksum = Hash(checksum, sim.projectiles.py.data(), sim.projectiles.count * sizeof(float));
+
+    printf("obstacles    %zu\n", sim.obstacles->size());
+    if (sim.world != nullptr)
+        printf("chunks       %d read ahead, %d stalls, %d evicted\n", world.loads, world.stalls, world.evictions);
+    printf("bodies       %zu\n", sim.physics.bodies.size());
+    printf("ticks        %llu\n", (unsigned long long)ticks);
+    printf("ticks/s      %.1f\n", ticks / (totalMs / 1000.0));
+    printf("input        %9.3f ms  %8.3f us/tick\n", Milliseconds(inputTime), Milliseconds(inputTime) * 1000.0 / ticks);
+    printf("grid         %9.3f ms  %8.3f us/tick\n", Milliseconds(gridTime), Milliseconds(gridTime) * 1000.0 / ticks);
+    printf("physics      %9.3f ms  %8.3f us/tick\n", Milliseconds(physicsTime), Milliseconds(physicsTime) * 1000.0 / ticks);
+    printf("projectiles  %9.3f ms  %8.3f us/tick  (%llu hits, %d max in flight)\n", Milliseconds(projectileTime), Milliseconds(projectileTime) * 1000.0 / ticks,
+        (unsigned long long)projectileHits, maxProjectiles);
+    printf("collision    %9.3f ms  %8.3f us/tick  (%d laser hits)\n", Milliseconds(collisionTime), Milliseconds(collisionTime) * 1000.0 / ticks, laserHits);
+    printf("checksum     %016llx\n", (unsigned long long)checksum);
+    StopWorldStream(world);
+    return 0;
+}
@@ -0,0 +1,223 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Opt-in heap allocation tracking
+// Build with ALLOC_TRACKER_ENABLED=1 (premake --alloctracker=on) to replace the global operator
+// new and delete with versions that count allocations and bytes per thread. ALLOC_TAG("name")
+// attributes allocations in the rest of its scope to name, so EndAllocFrame can report which
+// call sites allocate. ALLOC_TRACKER_ASSERT=1 (premake --alloctracker=assert) also makes
+// ForbidAllocations(true) fail at the allocation site, for catching any allocation in a
+// steady-state frame under a debugger; ALLOC_ALLOW_IF(condition) exempts deliberate work.
+// Replaces the global operators, so include it from exactly one translation unit.
+
+#ifndef ALLOC_TRACKER_ENABLED
+#define ALLOC_TRACKER_ENABLED 0
+#endif
+
+#ifndef ALLOC_TRACKER_ASSERT
+#define ALLOC_TRACKER_ASSERT 0
+#endif
+
+struct AllocTagCount
+{
+    const char* name;
+    uint64_t allocations;
+    uint64_t bytes;
+};
+
+const int allocTagCapacity = 16;
+
+// Only ever touched by the owning thread; constant-initialised so operator new can use it
+// before anything else on the thread has run
+struct AllocCounters
+{
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    uint64_t bytes = 0;
+
+    // Since the last EndAllocFrame
+    uint64_t frameAllocations = 0;
+    uint64_t frameBytes = 0;
+    AllocTagCount tags[allocTagCapacity] = {};
+    int tagCount = 0;
+
+    const char* tag = "untagged";       // innermost ALLOC_TAG
+    bool forbidden = false;             // ForbidAllocations
+    int allowDepth = 0;                 // ALLOC_ALLOW_IF scopes currently allowing
+};
+
+thread_local AllocCounters allocCounters;
+
+struct AllocFrameStats
+{
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    const char* topTag = nullptr;       // tag with the most allocations this frame
+    uint64_t topTagAllocations = 0;
+};
+
+void TrackAllocation(size_t size)
+{
+    AllocCounters& counters = allocCounters;
+    counters.allocations++;
+    counters.bytes += size;
+    counters.frameAllocations++;
+    counters.frameBytes += size;
+
+    // Linear search is fine, there are only a handful of tags; the last slot collects the overflow
+    int i = 0;
+    while (i < counters.tagCount && counters.tags[i].name != counters.tag) i++;
+    if (i == allocTagCapacity)
+        i = allocTagCapacity - 1;
+    else if (i == counters.tagCount)
+    {
+        counters.tags[i].name = i == allocTagCapacity - 1 ? "other" : counters.tag;
+        counters.tagCount++;
+    }
+    counters.tags[i].allocations++;
+    counters.tags[i].bytes += size;
+
+#if ALLOC_TRACKER_ASSERT
+    if (counters.forbidden && counters.allowDepth == 0)
+    {
+        fprintf(stderr, "allocation of %zu bytes in a steady-state frame (tag: %s)\n", size, counters.tag);
+        abort();
+    }
+#endif
+}
+
+// Allocations on the calling thread since its last EndAllocFrame
+AllocFrameStats EndAllocFrame()
+{
+    AllocCounters& counters = allocCounters;
+    AllocFrameStats stats;
+    stats.allocations = counters.frameAllocations;
+    stats.bytes = counters.frameBytes;
+    for (int i = 0; i < counters.tagCount; i++)
+    {
+        if (counters.tags[i].allocations > stats.topTagAllocations)
+        {
+            stats.topTag = counters.tags[i].name;
+            stats.topTagAllocations = counters.tags[i].allocations;
+        }
+        counters.tags[i] = AllocTagCount{};
+    }
+    counters.tagCount = 0;
+    counters.frameAllocations = 0;
+    counters.frameBytes = 0;
+    return stats;
+}
+
+// Fails any later allocation on the calling thread until turned off (ALLOC_TRACKER_ASSERT only)
+void ForbidAllocations(bool forbid)
+{
+    allocCounters.forbidden = forbid;
+}
+
+struct AllocTagScope
+{
+    const char* previous;
+    explicit AllocTagScope(const char* name) : previous(allocCounters.tag) { allocCounters.tag = name; }
+    ~AllocTagScope() { allocCounters.tag = previous; }
+};
+
+struct AllocAllowScope
+{
+    bool allow;
+    explicit AllocAllowScope(bool condition) : allow(condition) { if (allow) allocCounters.allowDepth++; }
+    ~AllocAllowScope() { if (allow) allocCounters.allowDepth--; }
+};
+
+#define ALLOC_CONCAT_INNER(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_INNER(a, b)
+
+#if ALLOC_TRACKER_ENABLED
+#define ALLOC_TAG(name) AllocTagScope ALLOC_CONCAT(allocTag, __LINE__)(name)
+#define ALLOC_ALLOW_IF(condition) AllocAllowScope ALLOC_CONCAT(allocAllow, __LINE__)(condition)
+
+void* operator new(size_t size)
+{
+    TrackAllocation(size);
+    void* p = malloc(size > 0 ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    if (p == nullptr) return;
+    allocCounters.frees++;
+    free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    operator delete(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    operator delete(p);
+}
+
+#ifdef __cpp_aligned_new
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    TrackAllocation(size);
+#ifdef _MSC_VER
+    void* p = _aligned_malloc(size > 0 ? size : 1, (size_t)alignment);
+#else
+    void* p = aligned_alloc((size_t)alignment, ((size > 0 ? size : 1) + (size_t)alignment - 1) / (size_t)alignment * (size_t)alignment);
+#endif
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    if (p == nullptr) return;
+    allocCounters.frees++;
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+void operator delete[](void* p, std::align_val_t alignment) noexcept
+{
+    operator delete(p, alignment);
+}
+
+void operator delete(void* p, size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(p, alignment);
+}
+
+void operator delete[](void* p, size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(p, alignment);
+}
+#endif
+#else
+#define ALLOC_TAG(name)
+#define ALLOC_ALLOW_IF(condition)
+#endif
@@ -0,0 +1,216 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Allocators for transient and fixed-size data, so steady-state frames stay off the global heap
+
+//----------------------------------------------------------------------------------
+// Arena
+//----------------------------------------------------------------------------------
+// Bump allocator over one block: allocation is an add and a compare, and everything is freed
+// at once by ResetArena. Nothing is destructed, so only use it for trivially destructible data
+// (or containers whose elements are). If a frame needs more than the block holds, the excess
+// comes from malloc and the block is regrown to fit at the next reset, so an undersized arena
+// costs a few allocations once rather than failing.
+
+struct Arena
+{
+    unsigned char* base = nullptr;
+    size_t capacity = 0;
+    size_t offset = 0;
+    size_t peak = 0;                    // most ever used between resets, including overflow
+    size_t overflowBytes = 0;
+    std::vector<void*> overflow;        // malloc'd blocks freed at the next reset
+};
+
+// Throws std::bad_alloc, like an overflowing ArenaAlloc, if the block can't be allocated
+void InitArena(Arena& arena, size_t capacity)
+{
+    free(arena.base);
+    arena.base = (unsigned char*)malloc(capacity > 0 ? capacity : 1);
+    if (arena.base == nullptr)
+    {
+        printf("InitArena: failed to allocate %zu bytes\n", capacity);
+        arena.capacity = arena.offset = 0;
+        throw std::bad_alloc();
+    }
+    arena.capacity = capacity;
+    arena.offset = 0;
+    arena.overflowBytes = 0;
+    arena.overflow.reserve(64);
+}
+
+void* ArenaAlloc(Arena& arena, size_t size, size_t alignment = alignof(std::max_align_t))
+{
+    const size_t start = (arena.offset + alignment - 1) & ~(alignment - 1);
+    if (start + size <= arena.capacity)
+    {
+        arena.offset = start + size;
+        if (arena.offset + arena.overflowBytes > arena.peak) arena.peak = arena.offset + arena.overflowBytes;
+        return arena.base + start;
+    }
+
+    // malloc aligns to max_align_t, which covers everything the game allocates
+    void* p = malloc(size > 0 ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    arena.overflow.push_back(p);
+    arena.overflowBytes += size;
+    if (arena.offset + arena.overflowBytes > arena.peak) arena.peak = arena.offset + arena.overflowBytes;
+    return p;
+}
+
+template<typename T>
+T* ArenaArray(Arena& arena, size_t count)
+{
+    return (T*)ArenaAlloc(arena, count * sizeof(T), alignof(T));
+}
+
+// Frees everything allocated since the last reset
+void ResetArena(Arena& arena)
+{
+    if (!arena.overflow.empty())
+    {
+        for (void* p : arena.overflow) free(p);
+        arena.overflow.clear();
+        InitArena(arena, arena.peak + arena.peak / 2);
+    }
+    arena.offset = 0;
+    arena.overflowBytes = 0;
+}
+
+void DestroyArena(Arena& arena)
+{
+    for (void* p : arena.overflow) free(p);
+    free(arena.base);
+    arena = Arena{};
+}
+
+// Two arenas used on alternate frames: data allocated this frame is still valid next frame,
+// e.g. for results produced by one frame and consumed by the next
+struct FrameArenas
+{
+    Arena arenas[2];
+    int current = 0;
+};
+
+void InitFrameArenas(FrameArenas& frame, size_t capacity)
+{
+    InitArena(frame.arenas[0], capacity);
+    InitArena(frame.arenas[1], capacity);
+    frame.current = 0;
+}
+
+Arena& CurrentArena(FrameArenas& frame)
+{
+    return frame.arenas[frame.current];
+}
+
+// Last frame's arena, untouched until the frame after this one
+Arena& PreviousArena(FrameArenas& frame)
+{
+    return frame.arenas[frame.current ^ 1];
+}
+
+// Call once at the end of every frame
+void NextFrameArena(FrameArenas& frame)
+{
+    frame.current ^= 1;
+    ResetArena(frame.arenas[frame.current]);
+}
+
+void DestroyFrameArenas(FrameArenas& frame)
+{
+    DestroyArena(frame.arenas[0]);
+    DestroyArena(frame.arenas[1]);
+}
+
+//----------------------------------------------------------------------------------
+// STL adapter
+//----------------------------------------------------------------------------------
+// Lets standard containers allocate from an arena, e.g.
+//     std::vector<int, ArenaAllocator<int>> items{ ArenaAllocator<int>(arena) };
+// Deallocation is a no-op; memory comes back when the arena is reset, so such containers
+// must not outlive the reset.
+
+template<typename T>
+struct ArenaAllocator
+{
+    typedef T value_type;
+    Arena* arena;
+
+    explicit ArenaAllocator(Arena& a) : arena(&a) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) { return ArenaArray<T>(*arena, count); }
+    void deallocate(T*, size_t) {}
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena == b.arena; }
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena != b.arena; }
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+//----------------------------------------------------------------------------------
+// Pool
+//----------------------------------------------------------------------------------
+// Fixed number of T slots allocated up front with an intrusive free list, for objects that
+// come and go individually. Create and Destroy are O(1) and never touch the heap; Create
+// returns null when every slot is in use. bench-pool times them against new and delete.
+
+template<typename T>
+struct Pool
+{
+    union Slot
+    {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<Slot> slots;
+    Slot* freeList = nullptr;
+    int live = 0;
+};
+
+template<typename T>
+void InitPool(Pool<T>& pool, int capacity)
+{
+    pool.slots.resize(capacity);
+    pool.freeList = nullptr;
+    for (int i = capacity - 1; i >= 0; i--)
+    {
+        pool.slots[i].next = pool.freeList;
+        pool.freeList = &pool.slots[i];
+    }
+    pool.live = 0;
+}
+
+template<typename T, typename... Args>
+T* PoolCreate(Pool<T>& pool, Args&&... args)
+{
+    if (pool.freeList == nullptr) return nullptr;
+    typename Pool<T>::Slot* slot = pool.freeList;
+    pool.freeList = slot->next;
+    pool.live++;
+    return new (slot->storage) T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void PoolDestroy(Pool<T>& pool, T* object)
+{
+    if (object == nullptr) return;
+    object->~T();
+    typename Pool<T>::Slot* slot = (typename Pool<T>::Slot*)object;
+    slot->next = pool.freeList;
+    pool.freeList = slot;
+    pool.live--;
+}
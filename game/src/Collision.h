@@ -4,6 +4,7 @@
 #include <array>
 #include <vector>
 #include <algorithm>
+#include <cstdio>
 
 struct Circle
 {
@@ -56,7 +57,7 @@ bool CheckCollisionLineRec(Vector2 lineStart, Vector2 lineEnd, Rectangle rectang
     };
 
     std::array<Vector2, 4> intersections;
-    intersections.assign(Vector2One() * 100000.0f);
+    intersections.fill(Vector2One() * 100000.0f);
 
     bool collision = false;
     for (size_t i = 0; i < points.size(); i++)
@@ -86,7 +87,6 @@ bool IsCircleVisible(Vector2 lineStart, Vector2 lineEnd, Circle circle, const st
     if (!CheckCollisionLineCircle(lineStart, lineEnd, circle)) return false;
     float targetDistance = DistanceSqr(lineStart, circle.position);
 
-    std::vector<Vector2> intersections(obstacles.size());
     for (const Rectangle& obstacle : obstacles)
     {
         Vector2 poi;
@@ -107,7 +107,6 @@ bool IsRectangleVisible(Vector2 lineStart, Vector2 lineEnd, Rectangle rectangle,
     float targetDistance = DistanceSqr(lineStart, 
         { rectangle.x + rectangle.width * 0.5f, rectangle.y + rectangle.height * 0.5f});
 
-    std::vector<Vector2> intersections(obstacles.size());
     for (const Rectangle& obstacle : obstacles)
     {
         Vector2 poi;
@@ -123,26 +122,422 @@ bool IsRectangleVisible(Vector2 lineStart, Vector2 lineEnd, Rectangle rectangle,
 
 bool NearestIntersection(Vector2 lineStart, Vector2 lineEnd, const std::vector<Rectangle>& obstacles, Vector2& poi)
 {
+    // Keeps the nearest hit as it goes rather than collecting them all
     bool collision = false;
-    std::vector<Vector2> intersections(obstacles.size());
+    float nearestDistance = 0.0f;
     for (const Rectangle& obstacle : obstacles)
     {
-        if (CheckCollisionLineRec(lineStart, lineEnd, obstacle, poi))
+        Vector2 hit;
+        if (CheckCollisionLineRec(lineStart, lineEnd, obstacle, hit))
         {
-            intersections.push_back(poi);
+            const float distance = DistanceSqr(lineStart, hit);
+            if (!collision || distance < nearestDistance)
+            {
+                nearestDistance = distance;
+                poi = hit;
+            }
             collision = true;
         }
     }
 
-    if (collision)
+    return collision;
+}
+
+// Smallest axis-aligned rectangle containing rectangle after transform, e.g. for culling
+// Maps the centre and the half extents instead of all four corners
+Rectangle TransformRectangle(Rectangle rectangle, Affine2 transform)
+{
+    const Vector2 extents{ rectangle.width * 0.5f, rectangle.height * 0.5f };
+    const Vector2 center = Multiply(Vector2{ rectangle.x + extents.x, rectangle.y + extents.y }, transform);
+    const float x = fabsf(transform.m0) * extents.x + fabsf(transform.m4) * extents.y;
+    const float y = fabsf(transform.m1) * extents.x + fabsf(transform.m5) * extents.y;
+    return Rectangle{ center.x - x, center.y - y, x * 2.0f, y * 2.0f };
+}
+
+void TransformRectangles(const Rectangle* rectangles, Rectangle* out, int count, Affine2 transform)
+{
+    for (int i = 0; i < count; i++) out[i] = TransformRectangle(rectangles[i], transform);
+}
+
+
+// Uniform grid over static obstacles
+// Obstacle indices are counting-sorted by cell so each cell is a contiguous run of items.
+// A freshly built grid is packed; once obstacles are added and removed in place (see below)
+// each run can be followed by spare slots up to the next cell's start.
+struct ObstacleGrid
+{
+    Vector2 origin{ 0.0f, 0.0f };
+    float cellSize = 0.0f;
+    float invCellSize = 0.0f;
+    int width = 0;
+    int height = 0;
+    std::vector<int> cellStart; // width * height + 1 offsets into items
+    std::vector<int> cellCount; // items in use from each cell's start
+    std::vector<int> items;     // obstacle indices grouped by cell
+};
+
+// The same grid over arrays owned elsewhere, e.g. a memory-mapped level file (see LevelFile.h)
+// Always packed. The queries below take either kind of grid.
+struct ObstacleGridView
+{
+    Vector2 origin{ 0.0f, 0.0f };
+    float cellSize = 0.0f;
+    float invCellSize = 0.0f;
+    int width = 0;
+    int height = 0;
+    const int* cellStart = nullptr;
+    const int* items = nullptr;
+};
+
+// Range of items holding cell's obstacles
+int CellBegin(const ObstacleGrid& grid, int cell)
+{
+    return grid.cellStart[cell];
+}
+
+int CellEnd(const ObstacleGrid& grid, int cell)
+{
+    return grid.cellStart[cell] + grid.cellCount[cell];
+}
+
+int CellBegin(const ObstacleGridView& grid, int cell)
+{
+    return grid.cellStart[cell];
+}
+
+int CellEnd(const ObstacleGridView& grid, int cell)
+{
+    return grid.cellStart[cell + 1];
+}
+
+// Obstacles as separate coordinate arrays owned elsewhere
+// The queries take these or a std::vector<Rectangle>
+struct RectangleArrays
+{
+    const float* x = nullptr;
+    const float* y = nullptr;
+    const float* width = nullptr;
+    const float* height = nullptr;
+    int count = 0;
+};
+
+Rectangle ObstacleAt(const std::vector<Rectangle>& obstacles, int index)
+{
+    return obstacles[index];
+}
+
+Rectangle ObstacleAt(const RectangleArrays& obstacles, int index)
+{
+    return Rectangle{ obstacles.x[index], obstacles.y[index], obstacles.width[index], obstacles.height[index] };
+}
+
+struct CellRange
+{
+    int xMin, yMin, xMax, yMax;
+};
+
+// Cells overlapped by area, clamped to the grid (empty if xMin > xMax or yMin > yMax)
+template<typename Grid>
+CellRange GetCellRange(const Grid& grid, Rectangle area)
+{
+    CellRange range;
+    range.xMin = std::max(0, (int)floorf((area.x - grid.origin.x) * grid.invCellSize));
+    range.yMin = std::max(0, (int)floorf((area.y - grid.origin.y) * grid.invCellSize));
+    range.xMax = std::min(grid.width - 1, (int)floorf((area.x + area.width - grid.origin.x) * grid.invCellSize));
+    range.yMax = std::min(grid.height - 1, (int)floorf((area.y + area.height - grid.origin.y) * grid.invCellSize));
+    return range;
+}
+
+// Counting-sorts obstacles into grid, whose origin, cell size and dimensions are already set
+// Each obstacle is listed in the cells it overlaps after growing it by margin on every side;
+// listing one in a few cells too many costs a little query time but never a wrong result.
+void FillObstacleGrid(ObstacleGrid& grid, const std::vector<Rectangle>& obstacles, float margin)
+{
+    auto cellsOf = [&](const Rectangle& obstacle)
     {
-        poi = *std::min_element(intersections.begin(), intersections.end(),
-            [&lineStart](const Vector2& a, const Vector2& b)
+        if (margin == 0.0f) return GetCellRange(grid, obstacle);
+        return GetCellRange(grid, Rectangle{ obstacle.x - margin, obstacle.y - margin,
+            obstacle.width + margin * 2.0f, obstacle.height + margin * 2.0f });
+    };
+
+    // Counting sort: count per cell, prefix sum, then scatter
+    grid.cellStart.assign(grid.width * grid.height + 1, 0);
+    for (const Rectangle& obstacle : obstacles)
+    {
+        CellRange range = cellsOf(obstacle);
+        for (int y = range.yMin; y <= range.yMax; y++)
+            for (int x = range.xMin; x <= range.xMax; x++)
+                grid.cellStart[y * grid.width + x + 1]++;
+    }
+
+    for (size_t i = 1; i < grid.cellStart.size(); i++)
+        grid.cellStart[i] += grid.cellStart[i - 1];
+
+    grid.items.resize(grid.cellStart.back());
+    grid.cellCount.assign(grid.width * grid.height, 0);
+    for (size_t i = 0; i < obstacles.size(); i++)
+    {
+        CellRange range = cellsOf(obstacles[i]);
+        for (int y = range.yMin; y <= range.yMax; y++)
+        {
+            for (int x = range.xMin; x <= range.xMax; x++)
             {
-                return DistanceSqr(lineStart, a) < DistanceSqr(lineStart, b);
+                const int cell = y * grid.width + x;
+                grid.items[grid.cellStart[cell] + grid.cellCount[cell]++] = (int)i;
             }
-        );
+        }
     }
+}
 
-    return collision;
+void BuildObstacleGrid(ObstacleGrid& grid, const std::vector<Rectangle>& obstacles, float cellSize)
+{
+    grid.cellStart.clear();
+    grid.cellCount.clear();
+    grid.items.clear();
+    grid.width = grid.height = 0;
+    if (obstacles.empty()) return;
+
+    // Coarsening below would never end, so leave the grid empty
+    if (!(cellSize > 0.0f))
+    {
+        printf("BuildObstacleGrid: cell size %f is not positive\n", cellSize);
+        return;
+    }
+
+    Vector2 min{ obstacles[0].x, obstacles[0].y };
+    Vector2 max{ obstacles[0].x + obstacles[0].width, obstacles[0].y + obstacles[0].height };
+    for (const Rectangle& obstacle : obstacles)
+    {
+        min.x = std::min(min.x, obstacle.x);
+        min.y = std::min(min.y, obstacle.y);
+        max.x = std::max(max.x, obstacle.x + obstacle.width);
+        max.y = std::max(max.y, obstacle.y + obstacle.height);
+    }
+
+    // Coarsen the grid if the requested cell size would need far more cells than obstacles
+    const float maxCells = std::max(1024.0f, obstacles.size() * 4.0f);
+    while (((max.x - min.x) / cellSize + 1.0f) * ((max.y - min.y) / cellSize + 1.0f) > maxCells)
+        cellSize *= 2.0f;
+
+    grid.origin = min;
+    grid.cellSize = cellSize;
+    grid.invCellSize = 1.0f / cellSize;
+    grid.width = (int)((max.x - min.x) * grid.invCellSize) + 1;
+    grid.height = (int)((max.y - min.y) * grid.invCellSize) + 1;
+    FillObstacleGrid(grid, obstacles, 0.0f);
+}
+
+// Incremental updates, for when a few obstacles change and a full build would stall
+// Changing an obstacle only touches the cells it overlaps. A cell with no spare slot left
+// makes RepackObstacleGrid move every run to leave some, which costs a pass over the items
+// but, unlike a build, never recomputes another obstacle's cells.
+
+// Moves the runs so each cell has spare slots for about a quarter more items
+// With spare false the grid is packed, as BuildObstacleGrid leaves it
+void RepackObstacleGrid(ObstacleGrid& grid, bool spare)
+{
+    const int cells = grid.width * grid.height;
+    std::vector<int> cellStart(cells + 1, 0);
+    for (int cell = 0; cell < cells; cell++)
+    {
+        const int count = grid.cellCount[cell];
+        cellStart[cell + 1] = cellStart[cell] + count + (spare ? count / 4 + 2 : 0);
+    }
+
+    std::vector<int> items(cellStart.back());
+    for (int cell = 0; cell < cells; cell++)
+        std::copy(grid.items.begin() + grid.cellStart[cell], grid.items.begin() + CellEnd(grid, cell), items.begin() + cellStart[cell]);
+    grid.cellStart.swap(cellStart);
+    grid.items.swap(items);
+}
+
+// True if obstacle lies entirely inside the grid, so it can be added without a rebuild
+bool GridCovers(const ObstacleGrid& grid, Rectangle obstacle)
+{
+    return grid.width > 0 && obstacle.x >= grid.origin.x && obstacle.y >= grid.origin.y &&
+        obstacle.x + obstacle.width < grid.origin.x + grid.width * grid.cellSize &&
+        obstacle.y + obstacle.height < grid.origin.y + grid.height * grid.cellSize;
+}
+
+// Adds obstacle as index, returns false if it isn't inside the grid and a rebuild is needed
+bool AddToObstacleGrid(ObstacleGrid& grid, Rectangle obstacle, int index)
+{
+    if (!GridCovers(grid, obstacle)) return false;
+
+    const CellRange range = GetCellRange(grid, obstacle);
+    for (int y = range.yMin; y <= range.yMax; y++)
+    {
+        for (int x = range.xMin; x <= range.xMax; x++)
+        {
+            const int cell = y * grid.width + x;
+            if (CellEnd(grid, cell) == grid.cellStart[cell + 1]) RepackObstacleGrid(grid, true);
+            grid.items[grid.cellStart[cell] + grid.cellCount[cell]++] = index;
+        }
+    }
+    return true;
+}
+
+// Removes index, which must have been added with the same obstacle
+void RemoveFromObstacleGrid(ObstacleGrid& grid, Rectangle obstacle, int index)
+{
+    const CellRange range = GetCellRange(grid, obstacle);
+    for (int y = range.yMin; y <= range.yMax; y++)
+    {
+        for (int x = range.xMin; x <= range.xMax; x++)
+        {
+            // Order within a cell doesn't matter, so the last item fills the gap
+            const int cell = y * grid.width + x;
+            const int last = CellEnd(grid, cell) - 1;
+            for (int i = grid.cellStart[cell]; i <= last; i++)
+            {
+                if (grid.items[i] != index) continue;
+                grid.items[i] = grid.items[last];
+                grid.cellCount[cell]--;
+                break;
+            }
+        }
+    }
+}
+
+// Changes obstacle's index from one to another, e.g. after it was moved within the obstacle array
+void RenumberInObstacleGrid(ObstacleGrid& grid, Rectangle obstacle, int from, int to)
+{
+    const CellRange range = GetCellRange(grid, obstacle);
+    for (int y = range.yMin; y <= range.yMax; y++)
+    {
+        for (int x = range.xMin; x <= range.xMax; x++)
+        {
+            const int cell = y * grid.width + x;
+            for (int i = grid.cellStart[cell]; i < CellEnd(grid, cell); i++)
+            {
+                if (grid.items[i] != from) continue;
+                grid.items[i] = to;
+                break;
+            }
+        }
+    }
+}
+
+// Calls visit(index) once for every obstacle overlapping area
+// An obstacle spanning several cells is only reported by the cell holding
+// the top-left corner of its overlap with area, so no visited-set is needed
+template<typename Grid, typename Obstacles, typename Visitor>
+void QueryObstacles(const Grid& grid, const Obstacles& obstacles, Rectangle area, Visitor&& visit)
+{
+    if (grid.width == 0) return;
+    CellRange range = GetCellRange(grid, area);
+    for (int y = range.yMin; y <= range.yMax; y++)
+    {
+        for (int x = range.xMin; x <= range.xMax; x++)
+        {
+            const int cell = y * grid.width + x;
+            for (int i = CellBegin(grid, cell); i < CellEnd(grid, cell); i++)
+            {
+                const int index = grid.items[i];
+                const Rectangle obstacle = ObstacleAt(obstacles, index);
+                if (obstacle.x > area.x + area.width || obstacle.x + obstacle.width < area.x ||
+                    obstacle.y > area.y + area.height || obstacle.y + obstacle.height < area.y)
+                    continue;
+
+                Rectangle corner{ std::max(obstacle.x, area.x), std::max(obstacle.y, area.y), 0.0f, 0.0f };
+                CellRange owner = GetCellRange(grid, corner);
+                if (owner.xMin == x && owner.yMin == y)
+                    visit(index);
+            }
+        }
+    }
+}
+
+// Entry time in [0, 1] of the segment start + t * delta into rectangle, or -1 if it misses
+// A segment starting inside the rectangle enters at t = 0
+float SegmentRecEntry(Vector2 start, Vector2 delta, Rectangle rectangle)
+{
+    float tMin = 0.0f;
+    float tMax = 1.0f;
+
+    const float starts[2] = { start.x, start.y };
+    const float deltas[2] = { delta.x, delta.y };
+    const float mins[2] = { rectangle.x, rectangle.y };
+    const float maxs[2] = { rectangle.x + rectangle.width, rectangle.y + rectangle.height };
+    for (int axis = 0; axis < 2; axis++)
+    {
+        if (deltas[axis] == 0.0f)
+        {
+            if (starts[axis] < mins[axis] || starts[axis] > maxs[axis]) return -1.0f;
+            continue;
+        }
+
+        const float inv = 1.0f / deltas[axis];
+        float t0 = (mins[axis] - starts[axis]) * inv;
+        float t1 = (maxs[axis] - starts[axis]) * inv;
+        if (t0 > t1) std::swap(t0, t1);
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if (tMin > tMax) return -1.0f;
+    }
+
+    return tMin;
+}
+
+// Nearest obstacle hit by the segment lineStart -> lineEnd, or -1 if none
+// Walks the grid cells along the segment in order and stops at the first cell that
+// contains a hit, so cost depends on the path length rather than the obstacle count
+template<typename Grid, typename Obstacles>
+int Raycast(const Grid& grid, const Obstacles& obstacles, Vector2 lineStart, Vector2 lineEnd, Vector2& poi)
+{
+    if (grid.width == 0) return -1;
+
+    const Vector2 delta = lineEnd - lineStart;
+    const Rectangle bounds{ grid.origin.x, grid.origin.y, grid.width * grid.cellSize, grid.height * grid.cellSize };
+    const float tEnter = SegmentRecEntry(lineStart, delta, bounds);
+    if (tEnter < 0.0f) return -1;
+
+    const Vector2 entry = lineStart + delta * tEnter;
+    int x = std::min(grid.width - 1, std::max(0, (int)floorf((entry.x - grid.origin.x) * grid.invCellSize)));
+    int y = std::min(grid.height - 1, std::max(0, (int)floorf((entry.y - grid.origin.y) * grid.invCellSize)));
+
+    // Segment time at which the next vertical / horizontal cell boundary is crossed
+    const int stepX = delta.x > 0.0f ? 1 : -1;
+    const int stepY = delta.y > 0.0f ? 1 : -1;
+    const float tDeltaX = delta.x != 0.0f ? grid.cellSize / fabsf(delta.x) : INFINITY;
+    const float tDeltaY = delta.y != 0.0f ? grid.cellSize / fabsf(delta.y) : INFINITY;
+    float tNextX = delta.x != 0.0f ? (grid.origin.x + (x + (stepX > 0)) * grid.cellSize - lineStart.x) / delta.x : INFINITY;
+    float tNextY = delta.y != 0.0f ? (grid.origin.y + (y + (stepY > 0)) * grid.cellSize - lineStart.y) / delta.y : INFINITY;
+
+    float best = INFINITY;
+    int bestIndex = -1;
+    while (true)
+    {
+        const int cell = y * grid.width + x;
+        for (int i = CellBegin(grid, cell); i < CellEnd(grid, cell); i++)
+        {
+            const int index = grid.items[i];
+            const float t = SegmentRecEntry(lineStart, delta, ObstacleAt(obstacles, index));
+            if (t >= 0.0f && t < best)
+            {
+                best = t;
+                bestIndex = index;
+            }
+        }
+
+        // Any obstacle entered before this cell's exit overlaps a cell already visited
+        const float tExit = std::min(tNextX, tNextY);
+        if (best <= tExit || tExit > 1.0f) break;
+
+        if (tNextX < tNextY)
+        {
+            x += stepX;
+            tNextX += tDeltaX;
+        }
+        else
+        {
+            y += stepY;
+            tNextY += tDeltaY;
+        }
+        if (x < 0 || x >= grid.width || y < 0 || y >= grid.height) break;
+    }
+
+    if (bestIndex >= 0)
+        poi = lineStart + delta * best;
+    return bestIndex;
 }
@@ -0,0 +1,108 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+// Lock-free primitives for handing data between exactly two threads
+// Neither side ever blocks or allocates once the buffers are sized.
+
+// Keeps producer and consumer counters on separate cache lines
+#define CACHE_LINE_SIZE 64
+
+//----------------------------------------------------------------------------------
+// Triple buffer
+//----------------------------------------------------------------------------------
+// The writer fills its own slot and swaps it with the shared one; the reader swaps the shared
+// slot for its own when a newer one has been published. The reader always sees the latest
+// complete value and the writer never waits for the reader to finish with it.
+// Slots are reused, so a T that holds vectors stops allocating once they have grown.
+
+template<typename T>
+struct TripleBuffer
+{
+    T slots[3];
+    alignas(CACHE_LINE_SIZE) std::atomic<int> shared{ 1 };     // slot index | fresh bit
+    alignas(CACHE_LINE_SIZE) int write = 0;                     // writer only
+    alignas(CACHE_LINE_SIZE) int read = 2;                      // reader only
+};
+
+const int tripleBufferFresh = 4;
+
+// Slot the writer may fill; it's never visible to the reader until Publish
+template<typename T>
+T& WriteSlot(TripleBuffer<T>& buffer)
+{
+    return buffer.slots[buffer.write];
+}
+
+// Hands the write slot to the reader and takes back whichever slot was shared
+template<typename T>
+void Publish(TripleBuffer<T>& buffer)
+{
+    const int previous = buffer.shared.exchange(buffer.write | tripleBufferFresh, std::memory_order_acq_rel);
+    buffer.write = previous & ~tripleBufferFresh;
+}
+
+// Swaps in the latest published slot, returns false if nothing new has been published
+template<typename T>
+bool Acquire(TripleBuffer<T>& buffer)
+{
+    if ((buffer.shared.load(std::memory_order_relaxed) & tripleBufferFresh) == 0) return false;
+    const int previous = buffer.shared.exchange(buffer.read, std::memory_order_acq_rel);
+    buffer.read = previous & ~tripleBufferFresh;
+    return true;
+}
+
+// Slot the reader owns until its next successful Acquire
+template<typename T>
+const T& ReadSlot(const TripleBuffer<T>& buffer)
+{
+    return buffer.slots[buffer.read];
+}
+
+//----------------------------------------------------------------------------------
+// Single-producer single-consumer queue
+//----------------------------------------------------------------------------------
+// Bounded ring of items; head and tail only ever increase and are masked on access.
+// Push fails when the ring is full rather than overwriting unread items.
+
+template<typename T>
+struct SpscQueue
+{
+    std::vector<T> items;
+    size_t mask = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head{ 0 };    // next item to pop, consumer only
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{ 0 };    // next item to push, producer only
+};
+
+// Capacity is rounded up to a power of two; call before either thread touches the queue
+template<typename T>
+void InitQueue(SpscQueue<T>& queue, size_t capacity)
+{
+    size_t size = 1;
+    while (size < capacity) size *= 2;
+    queue.items.assign(size, T{});
+    queue.mask = size - 1;
+    queue.head.store(0, std::memory_order_relaxed);
+    queue.tail.store(0, std::memory_order_relaxed);
+}
+
+template<typename T>
+bool Push(SpscQueue<T>& queue, const T& item)
+{
+    const size_t tail = queue.tail.load(std::memory_order_relaxed);
+    if (tail - queue.head.load(std::memory_order_acquire) > queue.mask) return false;
+    queue.items[tail & queue.mask] = item;
+    queue.tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+bool Pop(SpscQueue<T>& queue, T& item)
+{
+    const size_t head = queue.head.load(std::memory_order_relaxed);
+    if (head == queue.tail.load(std::memory_order_acquire)) return false;
+    item = queue.items[head & queue.mask];
+    queue.head.store(head + 1, std::memory_order_release);
+    return true;
+}
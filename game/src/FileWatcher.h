@@ -0,0 +1,139 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <thread>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+// Calls a function on a background thread whenever a file changes
+// Uses inotify on Linux and polls the file's size and modification time elsewhere, or when the
+// directory can't be watched (it doesn't exist, or the watch limit is reached). Changes are
+// reported once the file has been quiet for settleTime, so an editor writing in several steps
+// (or replacing the file through a rename) produces one call once it's done.
+
+struct FileWatcher
+{
+    std::string path;
+    std::function<void()> onChange;
+    std::thread thread;
+    std::atomic<bool> running{ false };
+};
+
+const std::chrono::milliseconds fileWatchSettleTime(150);
+const std::chrono::milliseconds fileWatchPollInterval(250);
+
+// Size and modification time, or zeros if the file doesn't exist
+struct FileStamp
+{
+    long long size = 0;
+    long long modified = 0;
+};
+
+FileStamp GetFileStamp(const char* path)
+{
+    FileStamp stamp;
+    struct stat info;
+    if (stat(path, &info) == 0)
+    {
+        stamp.size = (long long)info.st_size;
+        stamp.modified = (long long)info.st_mtime;
+    }
+    return stamp;
+}
+
+#ifdef __linux__
+// Watches the directory rather than the file, which editors often replace rather than rewrite
+// Returns false straight away if the watch can't be added, so the caller can poll instead
+bool WatchWithInotify(FileWatcher& watcher, int fd)
+{
+    const size_t slash = watcher.path.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : watcher.path.substr(0, slash + 1);
+    const std::string name = slash == std::string::npos ? watcher.path : watcher.path.substr(slash + 1);
+    if (inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY) < 0)
+    {
+        printf("%s: can't watch %s, polling instead\n", watcher.path.c_str(), directory.c_str());
+        return false;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    bool pending = false;
+    while (watcher.running.load(std::memory_order_relaxed))
+    {
+        // Wakes every so often to notice Stop; once something changed, waits for it to settle
+        pollfd request{ fd, POLLIN, 0 };
+        const int timeout = pending ? (int)fileWatchSettleTime.count() : 100;
+        if (poll(&request, 1, timeout) > 0)
+        {
+            const ssize_t length = read(fd, buffer, sizeof(buffer));
+            for (ssize_t offset = 0; offset < length;)
+            {
+                const inotify_event* event = (const inotify_event*)(buffer + offset);
+                if (event->len > 0 && name == event->name) pending = true;
+                offset += sizeof(inotify_event) + event->len;
+            }
+        }
+        else if (pending)
+        {
+            pending = false;
+            watcher.onChange();
+        }
+    }
+    return true;
+}
+#endif
+
+void WatchByPolling(FileWatcher& watcher)
+{
+    FileStamp last = GetFileStamp(watcher.path.c_str());
+    while (watcher.running.load(std::memory_order_relaxed))
+    {
+        std::this_thread::sleep_for(fileWatchPollInterval);
+        FileStamp stamp = GetFileStamp(watcher.path.c_str());
+        if (stamp.size == last.size && stamp.modified == last.modified) continue;
+
+        // Wait until it stops changing
+        do
+        {
+            last = stamp;
+            std::this_thread::sleep_for(fileWatchSettleTime);
+            stamp = GetFileStamp(watcher.path.c_str());
+        } while (stamp.size != last.size || stamp.modified != last.modified);
+        watcher.onChange();
+    }
+}
+
+void StartFileWatcher(FileWatcher& watcher, const char* path, std::function<void()> onChange)
+{
+    watcher.path = path;
+    watcher.onChange = onChange;
+    watcher.running.store(true);
+    watcher.thread = std::thread([&watcher]()
+        {
+#ifdef __linux__
+            const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (fd >= 0)
+            {
+                const bool watched = WatchWithInotify(watcher, fd);
+                close(fd);
+                if (watched) return;
+            }
+#endif
+            WatchByPolling(watcher);
+        });
+}
+
+// Waits for an onChange that is already running to return
+void StopFileWatcher(FileWatcher& watcher)
+{
+    watcher.running.store(false);
+    if (watcher.thread.joinable()) watcher.thread.join();
+}
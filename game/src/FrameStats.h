@@ -0,0 +1,141 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+// Frame and tick time distributions, so stutters show up instead of hiding in an average
+
+//----------------------------------------------------------------------------------
+// HDR histogram
+//----------------------------------------------------------------------------------
+// Counts durations in microseconds in log-linear buckets: each power of two is split into
+// 64 linear steps, so every value is kept to within 1/64 (1.6%) from 1 us to over a day
+// in a fixed 16 KB of counts, and recording is a couple of shifts and an increment.
+
+const int hdrSubBucketBits = 7;
+const int hdrSubBucketHalf = 1 << (hdrSubBucketBits - 1);
+const int hdrBucketCount = 31;                                  // values up to 2^37 us
+const int hdrCountsSize = (hdrBucketCount + 1) * hdrSubBucketHalf;
+
+struct HdrHistogram
+{
+    std::vector<uint64_t> counts;
+    uint64_t total = 0;
+};
+
+int HdrIndex(uint64_t value)
+{
+    int msb = 0;
+    for (uint64_t v = value | 1; v >>= 1;) msb++;
+    const int bucket = std::min(std::max(0, msb - hdrSubBucketBits + 1), hdrBucketCount - 1);
+    const uint64_t sub = std::min<uint64_t>(value >> bucket, (1 << hdrSubBucketBits) - 1);
+    return bucket * hdrSubBucketHalf + (int)sub;
+}
+
+// Largest value that lands in index, so percentiles err on the slow side
+uint64_t HdrValue(int index)
+{
+    const int bucket = index < 2 * hdrSubBucketHalf ? 0 : index / hdrSubBucketHalf - 1;
+    const uint64_t sub = index - bucket * hdrSubBucketHalf;
+    return ((sub + 1) << bucket) - 1;
+}
+
+void RecordValue(HdrHistogram& histogram, uint64_t value)
+{
+    if (histogram.counts.empty()) histogram.counts.assign(hdrCountsSize, 0);
+    histogram.counts[HdrIndex(value)]++;
+    histogram.total++;
+}
+
+// Takes back a value recorded earlier, for rolling windows
+void RemoveValue(HdrHistogram& histogram, uint64_t value)
+{
+    histogram.counts[HdrIndex(value)]--;
+    histogram.total--;
+}
+
+// Smallest value that at least percentile% of the recorded values are at or below
+uint64_t ValueAtPercentile(const HdrHistogram& histogram, double percentile)
+{
+    if (histogram.total == 0) return 0;
+    const uint64_t target = std::max<uint64_t>(1, (uint64_t)(percentile / 100.0 * histogram.total + 0.5));
+    uint64_t seen = 0;
+    for (int i = 0; i < hdrCountsSize; i++)
+    {
+        seen += histogram.counts[i];
+        if (seen >= target) return HdrValue(i);
+    }
+    return HdrValue(hdrCountsSize - 1);
+}
+
+//----------------------------------------------------------------------------------
+// Frame stats
+//----------------------------------------------------------------------------------
+
+// Milliseconds
+struct FrameTimeSummary
+{
+    float p50 = 0.0f, p95 = 0.0f, p99 = 0.0f, max = 0.0f;
+};
+
+// A whole-session histogram plus a rolling one over the last few seconds for live numbers
+// A frame slower than hitchMs is a hitch; detection is held off after startup and for
+// hitchCooldown frames after a hitch so a single stall doesn't report several times.
+struct FrameStats
+{
+    HdrHistogram session;
+    HdrHistogram window;
+    std::vector<uint32_t> recent;       // the window's values, oldest overwritten first
+    size_t head = 0;
+    size_t count = 0;
+
+    float hitchMs = 50.0f;
+    int hitchCooldown = 120;
+    int warmupFrames = 30;
+    int framesUntilDetection = 0;
+    int hitches = 0;
+};
+
+void InitFrameStats(FrameStats& stats, int windowFrames, float hitchMs)
+{
+    stats = FrameStats{};
+    stats.recent.assign(windowFrames, 0);
+    stats.hitchMs = hitchMs;
+    stats.framesUntilDetection = stats.warmupFrames;
+}
+
+// Records one frame or tick of the given length, returns true if it's a newly detected hitch
+bool RecordFrameTime(FrameStats& stats, float seconds)
+{
+    const uint32_t microseconds = (uint32_t)std::min(seconds * 1e6f, 4e9f);
+    RecordValue(stats.session, microseconds);
+
+    if (stats.count == stats.recent.size())
+        RemoveValue(stats.window, stats.recent[stats.head]);
+    else
+        stats.count++;
+    stats.recent[stats.head] = microseconds;
+    stats.head = (stats.head + 1) % stats.recent.size();
+    RecordValue(stats.window, microseconds);
+
+    if (stats.framesUntilDetection > 0)
+    {
+        stats.framesUntilDetection--;
+        return false;
+    }
+    if (seconds * 1000.0f <= stats.hitchMs) return false;
+
+    stats.hitches++;
+    stats.framesUntilDetection = stats.hitchCooldown;
+    return true;
+}
+
+FrameTimeSummary Summarize(const HdrHistogram& histogram)
+{
+    FrameTimeSummary summary;
+    summary.p50 = ValueAtPercentile(histogram, 50.0) / 1000.0f;
+    summary.p95 = ValueAtPercentile(histogram, 95.0) / 1000.0f;
+    summary.p99 = ValueAtPercentile(histogram, 99.0) / 1000.0f;
+    summary.max = ValueAtPercentile(histogram, 100.0) / 1000.0f;
+    return summary;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "raylib.h"
+#include "FileWatcher.h"
+#include "LevelFile.h"
+#include "ObstacleEdit.h"
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Reloads the obstacle file when it changes on disk
+// Loading and diffing happen on the watcher's thread; what reaches the simulation is an edit
+// (usually a handful of rectangles) it can apply in place, plus the whole new set for when its
+// obstacles have moved on from the edit's base, e.g. after a rewind.
+
+struct ObstacleReload
+{
+    std::shared_ptr<const ObstacleEdit> edit;
+    std::shared_ptr<const std::vector<Rectangle>> obstacles;    // the set after edit
+};
+
+struct ObstacleReloader
+{
+    FileWatcher watcher;
+
+    // Last set loaded, only touched by the watcher's thread once started
+    std::shared_ptr<const std::vector<Rectangle>> current;
+    uint32_t version = 0;
+
+    std::mutex mutex;
+    std::vector<ObstacleReload> pending;
+};
+
+// Runs on the watcher's thread; a file that fails to load (often one caught mid-save) is
+// reported and skipped, and the next change tries again
+void ReloadObstacles(ObstacleReloader& reloader)
+{
+    std::vector<Rectangle> loaded;
+    ObstacleGrid grid;
+    bool hasGrid = false;
+    if (!LoadObstacleFile(reloader.watcher.path.c_str(), loaded, grid, hasGrid)) return;
+
+    std::shared_ptr<ObstacleEdit> edit = std::make_shared<ObstacleEdit>();
+    DiffObstacles(*reloader.current, loaded, *edit);
+    if (edit->removed.empty() && edit->added.empty()) return;
+    edit->baseVersion = reloader.version;
+    edit->version = NewObstaclesVersion();
+
+    // Built by applying the edit rather than taken from the file, so it's in the order an
+    // in-place update produces and indices agree either way
+    std::shared_ptr<std::vector<Rectangle>> obstacles = std::make_shared<std::vector<Rectangle>>(*reloader.current);
+    ApplyObstacleEdit(*obstacles, *edit);
+    printf("reloaded %s: %zu removed, %zu added\n", reloader.watcher.path.c_str(), edit->removed.size(), edit->added.size());
+
+    reloader.current = obstacles;
+    reloader.version = edit->version;
+    std::lock_guard<std::mutex> lock(reloader.mutex);
+    reloader.pending.push_back(ObstacleReload{ edit, obstacles });
+}
+
+// Watches path, which obstacles (at version) were loaded from
+void StartObstacleReloader(ObstacleReloader& reloader, const char* path, const std::shared_ptr<const std::vector<Rectangle>>& obstacles, uint32_t version)
+{
+    reloader.current = obstacles;
+    reloader.version = version;
+    StartFileWatcher(reloader.watcher, path, [&reloader]() { ReloadObstacles(reloader); });
+}
+
+// Moves finished reloads into reloads, oldest first, without waiting on the watcher's thread
+void TakeObstacleReloads(ObstacleReloader& reloader, std::vector<ObstacleReload>& reloads)
+{
+    reloads.clear();
+    std::unique_lock<std::mutex> lock(reloader.mutex, std::try_to_lock);
+    if (lock.owns_lock()) reloads.swap(reloader.pending);
+}
+
+void StopObstacleReloader(ObstacleReloader& reloader)
+{
+    StopFileWatcher(reloader.watcher);
+}
@@ -0,0 +1,339 @@
+#pragma once
+#include "raylib.h"
+#include "Collision.h"
+#include "ObstacleFile.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Binary level files
+// A fixed header, then each obstacle coordinate as its own float array, then optionally the
+// obstacle grid's cellStart and items arrays, every array starting on a 64-byte boundary.
+// MapLevel maps the file and points RectangleArrays and an ObstacleGridView straight at it,
+// so the Collision.h queries run on the file's pages with no parse, copy or grid build.
+// Little-endian only, like every platform the game builds for. Written by the levelconvert tool.
+
+const uint32_t levelMagic = 0x4C564C53;     // "SLVL"
+const uint32_t levelVersion = 1;
+const uint32_t levelHasGrid = 1;
+const uint64_t levelAlignment = 64;
+
+struct LevelHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t flags;
+    uint32_t obstacleCount;
+    Rectangle bounds;                   // smallest rectangle containing every obstacle
+    uint64_t fileSize;
+
+    // Byte offsets from the start of the file
+    uint64_t x, y, width, height;
+
+    // Grid, if flags has levelHasGrid
+    Vector2 gridOrigin;
+    float cellSize;
+    int32_t gridWidth;
+    int32_t gridHeight;
+    uint32_t itemCount;
+    uint64_t cellStart;                 // gridWidth * gridHeight + 1 ints
+    uint64_t items;                     // itemCount ints
+};
+
+static_assert(sizeof(LevelHeader) == 112, "LevelHeader layout changed, bump levelVersion");
+
+// A mapped level; the views point into file and are valid until UnmapLevel
+struct Level
+{
+    MappedFile file;
+    const LevelHeader* header = nullptr;
+    RectangleArrays obstacles;
+    ObstacleGridView grid;              // width 0 if the file has no grid
+};
+
+void UnmapLevel(Level& level)
+{
+    UnmapFile(level.file);
+    level = Level{};
+}
+
+// True if the array at offset with count elements of size bytes lies inside the file
+bool LevelArrayFits(const LevelHeader& header, uint64_t offset, uint64_t count, uint64_t size)
+{
+    return offset % levelAlignment == 0 && offset >= sizeof(LevelHeader) &&
+        offset <= header.fileSize && count <= (header.fileSize - offset) / size;
+}
+
+// Checks a grid whose arrays fit the file: one pass over cellStart and items, so the cell
+// ranges and obstacle indices can be used unchecked by queries and by stitching chunks together
+// Returns null if the grid is sound, otherwise what's wrong with it
+const char* CheckLevelGrid(const LevelHeader& header, const char* data)
+{
+    if (!(header.cellSize > 0.0f)) return "grid cell size not positive";
+
+    const int* cellStart = (const int*)(data + header.cellStart);
+    const int64_t cells = (int64_t)header.gridWidth * header.gridHeight;
+    if (cellStart[0] < 0) return "grid cell ranges out of order";
+    for (int64_t cell = 0; cell < cells; cell++)
+        if (cellStart[cell + 1] < cellStart[cell]) return "grid cell ranges out of order";
+    if ((uint32_t)cellStart[cells] > header.itemCount) return "grid cell ranges past the items";
+
+    const int* items = (const int*)(data + header.items);
+    for (uint32_t i = 0; i < header.itemCount; i++)
+        if ((uint32_t)items[i] >= header.obstacleCount) return "grid item out of range";
+    return nullptr;
+}
+
+// Points level's views at a level image already in memory, e.g. a chunk of a world file
+// (see WorldFile.h); data must stay valid as long as the views are used. name is for errors.
+// The header, the array bounds and the grid's contents are checked; obstacle values aren't.
+bool ViewLevel(Level& level, const char* data, uint64_t size, const char* name)
+{
+    const LevelHeader* header = (const LevelHeader*)data;
+    const char* error = nullptr;
+    if (size < sizeof(uint32_t) || header->magic != levelMagic)
+        error = "not a level file";
+    else if (size < sizeof(LevelHeader) || header->fileSize != size)
+        error = "truncated";
+    else if (header->version != levelVersion)
+        error = "unsupported level version";
+    else if (!LevelArrayFits(*header, header->x, header->obstacleCount, sizeof(float)) ||
+        !LevelArrayFits(*header, header->y, header->obstacleCount, sizeof(float)) ||
+        !LevelArrayFits(*header, header->width, header->obstacleCount, sizeof(float)) ||
+        !LevelArrayFits(*header, header->height, header->obstacleCount, sizeof(float)))
+        error = "obstacle arrays out of range";
+    // The dimensions are checked against the file size (and int cell indices) before they're
+    // multiplied, so a corrupt header can't overflow the cell count into something that fits
+    else if ((header->flags & levelHasGrid) && (header->gridWidth <= 0 || header->gridHeight <= 0 ||
+        (uint64_t)header->gridWidth > std::min<uint64_t>(size / sizeof(int), INT32_MAX - 1) / (uint64_t)header->gridHeight ||
+        !LevelArrayFits(*header, header->cellStart, (uint64_t)header->gridWidth * header->gridHeight + 1, sizeof(int)) ||
+        !LevelArrayFits(*header, header->items, header->itemCount, sizeof(int))))
+        error = "grid arrays out of range";
+    else if (header->flags & levelHasGrid)
+        error = CheckLevelGrid(*header, data);
+    if (error != nullptr)
+    {
+        printf("%s: %s\n", name, error);
+        return false;
+    }
+
+    const char* base = data;
+    level.header = header;
+    level.obstacles.x = (const float*)(base + header->x);
+    level.obstacles.y = (const float*)(base + header->y);
+    level.obstacles.width = (const float*)(base + header->width);
+    level.obstacles.height = (const float*)(base + header->height);
+    level.obstacles.count = (int)header->obstacleCount;
+    if (header->flags & levelHasGrid)
+    {
+        level.grid.origin = header->gridOrigin;
+        level.grid.cellSize = header->cellSize;
+        level.grid.invCellSize = 1.0f / header->cellSize;
+        level.grid.width = header->gridWidth;
+        level.grid.height = header->gridHeight;
+        level.grid.cellStart = (const int*)(base + header->cellStart);
+        level.grid.items = (const int*)(base + header->items);
+    }
+    return true;
+}
+
+bool MapLevel(Level& level, const char* path)
+{
+    UnmapLevel(level);
+    if (!MapFile(level.file, path))
+    {
+        printf("failed to open %s\n", path);
+        return false;
+    }
+
+    if (!ViewLevel(level, level.file.data, level.file.size, path))
+    {
+        UnmapLevel(level);
+        return false;
+    }
+    return true;
+}
+
+// Copies a mapped level into the containers the simulation edits
+// grid is only written if the level has one; returns whether it did
+bool CopyLevel(const Level& level, std::vector<Rectangle>& obstacles, ObstacleGrid& grid)
+{
+    obstacles.resize(level.obstacles.count);
+    for (int i = 0; i < level.obstacles.count; i++)
+        obstacles[i] = ObstacleAt(level.obstacles, i);
+
+    if (level.grid.width == 0) return false;
+    const ObstacleGridView& view = level.grid;
+    grid.origin = view.origin;
+    grid.cellSize = view.cellSize;
+    grid.invCellSize = view.invCellSize;
+    grid.width = view.width;
+    grid.height = view.height;
+    grid.cellStart.assign(view.cellStart, view.cellStart + view.width * view.height + 1);
+    grid.cellCount.resize(view.width * view.height);
+    for (int cell = 0; cell < view.width * view.height; cell++)
+        grid.cellCount[cell] = view.cellStart[cell + 1] - view.cellStart[cell];
+    grid.items.assign(view.items, view.items + level.header->itemCount);
+    return true;
+}
+
+// First four bytes of a file, to tell binary formats from text; 0 if it can't be read
+uint32_t ReadFileMagic(const char* path)
+{
+    uint32_t magic = 0;
+    if (FILE* file = fopen(path, "rb"))
+    {
+        if (fread(&magic, sizeof(magic), 1, file) != 1) magic = 0;
+        fclose(file);
+    }
+    return magic;
+}
+
+// Replaces obstacles with those in a binary level or a text obstacle file, told apart by the
+// level magic; hasGrid says whether the file was a level with a grid, which is copied to grid
+bool LoadObstacleFile(const char* path, std::vector<Rectangle>& obstacles, ObstacleGrid& grid, bool& hasGrid)
+{
+    hasGrid = false;
+    if (ReadFileMagic(path) != levelMagic)
+    {
+        std::vector<Rectangle> loaded;
+        if (!LoadObstacles(path, loaded)) return false;
+        obstacles.swap(loaded);
+        return true;
+    }
+
+    Level level;
+    if (!MapLevel(level, path)) return false;
+    hasGrid = CopyLevel(level, obstacles, grid);
+    UnmapLevel(level);
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Writing
+//----------------------------------------------------------------------------------
+
+// Offsets are from where the level starts, which must itself be aligned
+
+// 64-bit file positions; long is 32 bits on Windows, too small for a large world file
+int64_t FileTell(FILE* file)
+{
+#ifdef _MSC_VER
+    return _ftelli64(file);
+#else
+    return (int64_t)ftello(file);
+#endif
+}
+
+bool FileSeek(FILE* file, int64_t offset)
+{
+#ifdef _MSC_VER
+    return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+    return fseeko(file, (off_t)offset, SEEK_SET) == 0;
+#endif
+}
+
+// Writes zeros up to the next aligned offset
+void PadLevelFile(FILE* file, uint64_t& offset)
+{
+    static const char zeros[levelAlignment] = {};
+    const uint64_t start = (offset + levelAlignment - 1) / levelAlignment * levelAlignment;
+    fwrite(zeros, 1, (size_t)(start - offset), file);
+    offset = start;
+}
+
+// Appends size bytes of data after padding, returns the offset it starts at
+uint64_t WriteLevelArray(FILE* file, uint64_t& offset, const void* data, size_t size)
+{
+    PadLevelFile(file, offset);
+    const uint64_t start = offset;
+    fwrite(data, 1, size, file);
+    offset = start + size;
+    return start;
+}
+
+// Writes a level image at file's current position, leaving the position at its end
+// grid may be null, otherwise it must have been built from obstacles; returns the image size
+uint64_t WriteLevel(FILE* file, const std::vector<Rectangle>& obstacles, const ObstacleGrid* grid)
+{
+    const int64_t start = FileTell(file);
+    LevelHeader header = {};
+    header.magic = levelMagic;
+    header.version = levelVersion;
+    header.obstacleCount = (uint32_t)obstacles.size();
+    if (!obstacles.empty())
+    {
+        Vector2 min{ obstacles[0].x, obstacles[0].y };
+        Vector2 max = min;
+        for (const Rectangle& obstacle : obstacles)
+        {
+            min.x = std::min(min.x, obstacle.x);
+            min.y = std::min(min.y, obstacle.y);
+            max.x = std::max(max.x, obstacle.x + obstacle.width);
+            max.y = std::max(max.y, obstacle.y + obstacle.height);
+        }
+        header.bounds = Rectangle{ min.x, min.y, max.x - min.x, max.y - min.y };
+    }
+
+    // Header first as a placeholder, rewritten once the offsets are known
+    fwrite(&header, sizeof(LevelHeader), 1, file);
+    uint64_t offset = sizeof(LevelHeader);
+
+    std::vector<float> column(obstacles.size());
+    uint64_t* columnOffsets[] = { &header.x, &header.y, &header.width, &header.height };
+    for (int c = 0; c < 4; c++)
+    {
+        for (size_t i = 0; i < obstacles.size(); i++)
+        {
+            const Rectangle& r = obstacles[i];
+            column[i] = c == 0 ? r.x : c == 1 ? r.y : c == 2 ? r.width : r.height;
+        }
+        *columnOffsets[c] = WriteLevelArray(file, offset, column.data(), column.size() * sizeof(float));
+    }
+
+    // Levels store the grid packed, so drop any spare slots left by incremental updates
+    ObstacleGrid packed;
+    if (grid != nullptr && grid->width > 0)
+    {
+        packed = *grid;
+        RepackObstacleGrid(packed, false);
+        grid = &packed;
+    }
+
+    if (grid != nullptr && grid->width > 0)
+    {
+        header.flags |= levelHasGrid;
+        header.gridOrigin = grid->origin;
+        header.cellSize = grid->cellSize;
+        header.gridWidth = grid->width;
+        header.gridHeight = grid->height;
+        header.itemCount = (uint32_t)grid->items.size();
+        header.cellStart = WriteLevelArray(file, offset, grid->cellStart.data(), grid->cellStart.size() * sizeof(int));
+        header.items = WriteLevelArray(file, offset, grid->items.data(), grid->items.size() * sizeof(int));
+    }
+    header.fileSize = offset;
+
+    FileSeek(file, start);
+    fwrite(&header, sizeof(LevelHeader), 1, file);
+    FileSeek(file, start + (int64_t)offset);
+    return offset;
+}
+
+// Writes obstacles, and grid if it isn't null, which must have been built from them
+bool SaveLevel(const char* path, const std::vector<Rectangle>& obstacles, const ObstacleGrid* grid)
+{
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr)
+    {
+        printf("failed to create %s\n", path);
+        return false;
+    }
+
+    WriteLevel(file, obstacles, grid);
+    const bool written = !ferror(file);
+    fclose(file);
+    if (!written) printf("failed to write %s\n", path);
+    return written;
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include "raylib.h"
+#include "Collision.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Changes between two versions of an obstacle set, so anything derived from the obstacles
+// (the grid, render geometry, copies on other threads) can be updated in place instead of
+// rebuilt. Versions identify obstacle sets: every distinct set gets a new one.
+
+uint32_t NewObstaclesVersion()
+{
+    static std::atomic<uint32_t> last{ 0 };
+    return ++last;
+}
+
+// Removing index i moves the last obstacle into i, as in a swap-and-pop, then added obstacles
+// are appended in order; ApplyObstacleEdit is the reference for the resulting order
+// Each removal also keeps the rectangles it touches, so a grid can follow the edit without
+// the base set.
+struct ObstacleEdit
+{
+    uint32_t baseVersion = 0;           // set the indices refer to
+    uint32_t version = 0;               // set after the edit
+    int baseCount = 0;                  // obstacles in the base set
+    std::vector<int> removed;           // descending
+    std::vector<Rectangle> removedObstacles;    // what was at each removed index
+    std::vector<Rectangle> movedObstacles;      // the last obstacle, moved into each removed index
+    std::vector<Rectangle> added;
+};
+
+// Recent edits, oldest first, shared between threads once made
+using ObstacleEditLog = std::vector<std::shared_ptr<const ObstacleEdit>>;
+
+// The edit in log that starts from version, or null if there isn't one
+const ObstacleEdit* FindObstacleEdit(const ObstacleEditLog& log, uint32_t version)
+{
+    for (const std::shared_ptr<const ObstacleEdit>& edit : log)
+        if (edit->baseVersion == version) return edit.get();
+    return nullptr;
+}
+
+// Fills edit's removals and added with the difference between two sets, compared bit for bit
+// Duplicates count separately, so a set holding a rectangle twice still diffs correctly
+void DiffObstacles(const std::vector<Rectangle>& before, const std::vector<Rectangle>& after, ObstacleEdit& edit)
+{
+    auto less = [](const Rectangle& a, const Rectangle& b) { return memcmp(&a, &b, sizeof(Rectangle)) < 0; };
+    std::vector<int> beforeOrder(before.size()), afterOrder(after.size());
+    for (size_t i = 0; i < before.size(); i++) beforeOrder[i] = (int)i;
+    for (size_t i = 0; i < after.size(); i++) afterOrder[i] = (int)i;
+    std::sort(beforeOrder.begin(), beforeOrder.end(), [&](int a, int b) { return less(before[a], before[b]); });
+    std::sort(afterOrder.begin(), afterOrder.end(), [&](int a, int b) { return less(after[a], after[b]); });
+
+    edit.baseCount = (int)before.size();
+    edit.removed.clear();
+    edit.removedObstacles.clear();
+    edit.movedObstacles.clear();
+    edit.added.clear();
+    std::vector<int> addedIndices;
+    size_t i = 0, j = 0;
+    while (i < beforeOrder.size() || j < afterOrder.size())
+    {
+        if (j == afterOrder.size() || (i < beforeOrder.size() && less(before[beforeOrder[i]], after[afterOrder[j]])))
+            edit.removed.push_back(beforeOrder[i++]);
+        else if (i == beforeOrder.size() || less(after[afterOrder[j]], before[beforeOrder[i]]))
+            addedIndices.push_back(afterOrder[j++]);
+        else
+        {
+            i++;
+            j++;
+        }
+    }
+
+    // Added in file order, so reloading an appended line appends one obstacle
+    std::sort(edit.removed.begin(), edit.removed.end(), [](int a, int b) { return a > b; });
+    std::sort(addedIndices.begin(), addedIndices.end());
+    for (int index : addedIndices) edit.added.push_back(after[index]);
+
+    // Follows the swap-and-pop by index to see what each removal takes out and moves in
+    std::vector<int>& at = beforeOrder;
+    for (size_t k = 0; k < before.size(); k++) at[k] = (int)k;
+    for (int index : edit.removed)
+    {
+        edit.removedObstacles.push_back(before[at[index]]);
+        edit.movedObstacles.push_back(before[at.back()]);
+        at[index] = at.back();
+        at.pop_back();
+    }
+}
+
+// Applies edit to obstacles, the set at edit.baseVersion
+void ApplyObstacleEdit(std::vector<Rectangle>& obstacles, const ObstacleEdit& edit)
+{
+    for (int index : edit.removed)
+    {
+        obstacles[index] = obstacles.back();
+        obstacles.pop_back();
+    }
+    obstacles.insert(obstacles.end(), edit.added.begin(), edit.added.end());
+}
+
+// Applies edit to a grid built from the set at edit.baseVersion, using only the rectangles
+// the edit keeps. Returns false if the grid couldn't follow (an added obstacle is outside it)
+// and must be rebuilt.
+bool ApplyObstacleEdit(ObstacleGrid& grid, const ObstacleEdit& edit)
+{
+    int count = edit.baseCount;
+    for (size_t k = 0; k < edit.removed.size(); k++)
+    {
+        const int index = edit.removed[k];
+        const int last = --count;
+        RemoveFromObstacleGrid(grid, edit.removedObstacles[k], index);
+        if (index != last)
+            RenumberInObstacleGrid(grid, edit.movedObstacles[k], last, index);
+    }
+
+    for (const Rectangle& obstacle : edit.added)
+        if (!AddToObstacleGrid(grid, obstacle, count++)) return false;
+    return true;
+}
+
+// Brings a grid built from the obstacles at version up to target by replaying log
+// Returns false if log doesn't reach from version to target, changing nothing, or if the
+// grid couldn't follow and must be rebuilt
+bool ReplayObstacleEdits(const ObstacleEditLog& log, uint32_t version, uint32_t target, ObstacleGrid& grid)
+{
+    // Check the whole chain first so a gap doesn't leave the grid half edited
+    uint32_t reached = version;
+    for (const ObstacleEdit* edit = FindObstacleEdit(log, reached); reached != target && edit != nullptr; edit = FindObstacleEdit(log, reached))
+        reached = edit->version;
+    if (reached != target) return false;
+
+    while (version != target)
+    {
+        const ObstacleEdit* edit = FindObstacleEdit(log, version);
+        if (!ApplyObstacleEdit(grid, *edit)) return false;
+        version = edit->version;
+    }
+    return true;
+}
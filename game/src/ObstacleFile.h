@@ -0,0 +1,311 @@
+#pragma once
+#include "raylib.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+// Declared by hand rather than including windows.h, whose names clash with raylib's
+extern "C"
+{
+    __declspec(dllimport) void* __stdcall CreateFileA(const char*, unsigned long, unsigned long, void*, unsigned long, unsigned long, void*);
+    __declspec(dllimport) int __stdcall GetFileSizeEx(void*, long long*);
+    __declspec(dllimport) void* __stdcall CreateFileMappingA(void*, void*, unsigned long, unsigned long, unsigned long, const char*);
+    __declspec(dllimport) void* __stdcall MapViewOfFile(void*, unsigned long, unsigned long, unsigned long, size_t);
+    __declspec(dllimport) int __stdcall UnmapViewOfFile(const void*);
+    __declspec(dllimport) int __stdcall CloseHandle(void*);
+}
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Obstacle text files: one "x y width height" rectangle per line, blank lines ignored
+// The file is memory-mapped and parsed in place with a locale-independent number scanner;
+// it is split at line breaks into one piece per whole megabyte, at most one per hardware thread,
+// and the pieces are parsed in parallel, so anything under 2 MB is parsed on one thread.
+
+//----------------------------------------------------------------------------------
+// Memory-mapped files
+//----------------------------------------------------------------------------------
+
+struct MappedFile
+{
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#endif
+};
+
+void UnmapFile(MappedFile& file)
+{
+#ifdef _WIN32
+    if (file.data != nullptr) UnmapViewOfFile(file.data);
+    if (file.mapping != nullptr) CloseHandle(file.mapping);
+    if (file.file != nullptr) CloseHandle(file.file);
+#else
+    if (file.data != nullptr) munmap((void*)file.data, file.size);
+#endif
+    file = MappedFile{};
+}
+
+// Maps path read-only; an empty file maps to null data and size 0
+bool MapFile(MappedFile& file, const char* path)
+{
+    UnmapFile(file);
+#ifdef _WIN32
+    const unsigned long genericRead = 0x80000000, shareRead = 1, shareWrite = 2, openExisting = 3;
+    const unsigned long sequentialScan = 0x08000000, pageReadOnly = 2, fileMapRead = 4;
+    void* handle = CreateFileA(path, genericRead, shareRead | shareWrite, nullptr, openExisting, sequentialScan, nullptr);
+    if (handle == (void*)-1) return false;
+    file.file = handle;
+
+    long long size = 0;
+    if (!GetFileSizeEx(handle, &size))
+    {
+        UnmapFile(file);
+        return false;
+    }
+    if (size == 0) return true;
+
+    file.mapping = CreateFileMappingA(handle, nullptr, pageReadOnly, 0, 0, nullptr);
+    file.data = file.mapping != nullptr ? (const char*)MapViewOfFile(file.mapping, fileMapRead, 0, 0, 0) : nullptr;
+    if (file.data == nullptr)
+    {
+        UnmapFile(file);
+        return false;
+    }
+    file.size = (size_t)size;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    // The mapping keeps the file alive, so the descriptor can go straight away
+    void* data = info.st_size > 0 ? mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+    close(fd);
+    if (data == MAP_FAILED) return false;
+    if (data != nullptr) madvise(data, info.st_size, MADV_SEQUENTIAL);
+    file.data = (const char*)data;
+    file.size = info.st_size;
+#endif
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Parsing
+//----------------------------------------------------------------------------------
+
+// Parses a decimal number such as "-12", "380.0" or "1.5e3" starting at p, returns the
+// character after it or null if there isn't one. Up to 19 significant digits are kept; with
+// at most 15 and a small exponent the result is the correctly rounded double, cast to float.
+const char* ScanFloat(const char* p, const char* end, float& value)
+{
+    static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool any = false;
+    for (; p < end && *p >= '0' && *p <= '9'; p++)
+    {
+        any = true;
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa != 0) digits++;
+        }
+        else
+            exponent++;
+    }
+    if (p < end && *p == '.')
+    {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++)
+        {
+            any = true;
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa != 0) digits++;
+                exponent--;
+            }
+        }
+    }
+    if (!any) return nullptr;
+
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char* q = p + 1;
+        bool negativeExponent = false;
+        if (q < end && (*q == '-' || *q == '+'))
+        {
+            negativeExponent = *q == '-';
+            q++;
+        }
+        if (q < end && *q >= '0' && *q <= '9')
+        {
+            int e = 0;
+            for (; q < end && *q >= '0' && *q <= '9'; q++)
+                e = std::min(e * 10 + (*q - '0'), 10000);
+            exponent += negativeExponent ? -e : e;
+            p = q;
+        }
+    }
+
+    double result = 0.0;
+    if (mantissa != 0 && exponent >= -22 && exponent <= 22 && mantissa <= (1ull << 53))
+        result = exponent < 0 ? mantissa / powers[-exponent] : mantissa * powers[exponent];
+    else if (mantissa != 0)
+        result = mantissa * pow(10.0, exponent);
+    value = (float)(negative ? -result : result);
+    return p;
+}
+
+// Outcome of parsing one run of whole lines
+struct ObstacleChunk
+{
+    const char* begin;
+    const char* end;
+    std::vector<Rectangle> obstacles;
+    int lines = 0;                      // line breaks in the chunk
+    int errorLine = 0;                  // 1-based within the chunk, 0 if it parsed
+    const char* error = nullptr;
+};
+
+bool IsBlank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+void ParseObstacleChunk(ObstacleChunk& chunk)
+{
+    const char* p = chunk.begin;
+    const char* end = chunk.end;
+    std::vector<Rectangle>& obstacles = chunk.obstacles;
+    obstacles.reserve((end - p) / 24 + 1);
+    int line = 1;
+    while (p < end)
+    {
+        while (p < end && IsBlank(*p)) p++;
+        if (p < end && *p != '\n')
+        {
+            float values[4];
+            for (int i = 0; i < 4; i++)
+            {
+                const char* next = ScanFloat(p, end, values[i]);
+                if (next == nullptr || (next < end && !IsBlank(*next) && *next != '\n'))
+                {
+                    chunk.errorLine = line;
+                    const bool lineEnded = next == nullptr && (p == end || *p == '\n');
+                    chunk.error = lineEnded && i > 0 ? "expected 4 numbers (x y width height)" : "expected a number";
+                    return;
+                }
+                p = next;
+                while (p < end && IsBlank(*p)) p++;
+            }
+            if (p < end && *p != '\n')
+            {
+                chunk.errorLine = line;
+                chunk.error = "unexpected text after height";
+                return;
+            }
+            if (values[2] < 0.0f || values[3] < 0.0f)
+            {
+                chunk.errorLine = line;
+                chunk.error = "negative width or height";
+                return;
+            }
+            obstacles.push_back(Rectangle{ values[0], values[1], values[2], values[3] });
+        }
+        if (p < end)
+        {
+            p++;
+            line++;
+        }
+    }
+    chunk.lines = line - 1;
+}
+
+// Appends the obstacles in text to obstacles, or prints the first bad line and returns false
+// leaving obstacles unchanged; name is only used in the message
+bool ParseObstacles(const char* text, size_t size, std::vector<Rectangle>& obstacles, const char* name)
+{
+    // Chunks of at least 1 MB so small files don't pay for threads
+    const size_t chunkBytes = 1 << 20;
+    const int chunkCount = (int)std::max<size_t>(1, std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), size / chunkBytes));
+
+    // Split at line breaks
+    std::vector<ObstacleChunk> chunks(chunkCount);
+    const char* end = text + size;
+    const char* start = text;
+    for (int i = 0; i < chunkCount; i++)
+    {
+        const char* split = i == chunkCount - 1 ? end : text + size / chunkCount * (i + 1);
+        split = std::max(split, start);
+        while (split < end && split[-1] != '\n') split++;
+        chunks[i].begin = start;
+        chunks[i].end = split;
+        start = split;
+    }
+
+    std::vector<std::thread> workers;
+    for (int i = 1; i < chunkCount; i++)
+        workers.emplace_back(ParseObstacleChunk, std::ref(chunks[i]));
+    ParseObstacleChunk(chunks[0]);
+    for (std::thread& worker : workers)
+        worker.join();
+
+    // A chunk that failed stopped counting lines, but every one before it is complete
+    int linesBefore = 0;
+    size_t total = 0;
+    for (const ObstacleChunk& chunk : chunks)
+    {
+        if (chunk.error != nullptr)
+        {
+            printf("%s:%d: %s\n", name, linesBefore + chunk.errorLine, chunk.error);
+            return false;
+        }
+        linesBefore += chunk.lines;
+        total += chunk.obstacles.size();
+    }
+
+    obstacles.reserve(obstacles.size() + total);
+    for (const ObstacleChunk& chunk : chunks)
+        obstacles.insert(obstacles.end(), chunk.obstacles.begin(), chunk.obstacles.end());
+    return true;
+}
+
+// Appends the obstacles in the file at path, returns false if it can't be read or parsed
+bool LoadObstacles(const char* path, std::vector<Rectangle>& obstacles)
+{
+    MappedFile file;
+    if (!MapFile(file, path))
+    {
+        printf("failed to open %s\n", path);
+        return false;
+    }
+    const bool parsed = ParseObstacles(file.data, file.size, obstacles, path);
+    UnmapFile(file);
+    return parsed;
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include "raylib.h"
+#include "Math.h"
+#include "Render.h"
+#include "Simulation.h"
+#include <vector>
+#include <cstring>
+
+// Fixed-capacity particle pool stored structure-of-arrays
+// Live particles are always [0, count); expired ones are swap-removed so the arrays stay dense.
+// Arrays are padded to a multiple of 4 so updates run on whole Vector4 groups.
+struct ParticlePool
+{
+    int capacity = 0;
+    int count = 0;
+    std::vector<float> px, py;
+    std::vector<float> vx, vy;
+    std::vector<float> life, maxLife;   // seconds remaining / at spawn
+    std::vector<Color> color;
+    float size = 3.0f;                  // half-extent at spawn, shrinks with remaining life
+
+    // Render data, rebuilt every frame and submitted with one draw call
+    GeometryBuffer geometry;
+    std::vector<float> vertices;
+    std::vector<Color> vertexColors;
+};
+
+void LoadParticles(ParticlePool& pool, int capacity)
+{
+    const int padded = (capacity + 3) & ~3;
+    pool.capacity = capacity;
+    pool.count = 0;
+    std::vector<float>* arrays[] = { &pool.px, &pool.py, &pool.vx, &pool.vy, &pool.life, &pool.maxLife };
+    for (std::vector<float>* array : arrays)
+        array->assign(padded, 0.0f);
+    pool.color.assign(padded, Color{});
+
+    pool.vertices.resize(capacity * 6 * 3);
+    pool.vertexColors.resize(capacity * 6);
+    LoadGeometryBuffer(pool.geometry, capacity * 6, true);
+}
+
+void UnloadParticles(ParticlePool& pool)
+{
+    UnloadGeometryBuffer(pool.geometry);
+    pool = ParticlePool{};
+}
+
+// Spawns count particles at position heading along direction +- spread radians
+// Particles that don't fit in the pool are dropped
+void EmitParticles(ParticlePool& pool, Rng& rng, Vector2 position, Vector2 direction, float spread,
+    float minSpeed, float maxSpeed, float minLife, float maxLife, Color color, int count)
+{
+    const float heading = Atan2(direction.y, direction.x);
+    count = std::min(count, pool.capacity - pool.count);
+    for (int n = 0; n < count; n++)
+    {
+        const int i = pool.count++;
+        const Vector2 velocity = Direction(heading + NextFloat(rng, -spread, spread)) * NextFloat(rng, minSpeed, maxSpeed);
+        pool.px[i] = position.x;
+        pool.py[i] = position.y;
+        pool.vx[i] = velocity.x;
+        pool.vy[i] = velocity.y;
+        pool.life[i] = pool.maxLife[i] = NextFloat(rng, minLife, maxLife);
+        pool.color[i] = color;
+    }
+}
+
+Vector4 Load4(const float* p)
+{
+    Vector4 v;
+    memcpy(&v, p, sizeof(Vector4));
+    return v;
+}
+
+void Store4(float* p, Vector4 v)
+{
+    memcpy(p, &v, sizeof(Vector4));
+}
+
+// Moves particles under gravity with linear drag, ages them and removes expired ones
+void UpdateParticles(ParticlePool& pool, float dt, Vector2 gravity, float drag)
+{
+    const float damping = 1.0f / (1.0f + drag * dt);
+    float* px = pool.px.data();
+    float* py = pool.py.data();
+    float* vx = pool.vx.data();
+    float* vy = pool.vy.data();
+    float* life = pool.life.data();
+
+    // Four particles per iteration; lanes past count are padding or dead particles and harmless
+    for (int i = 0; i < pool.count; i += 4)
+    {
+        const Vector4 velocityX = (Load4(vx + i) + gravity.x * dt) * damping;
+        const Vector4 velocityY = (Load4(vy + i) + gravity.y * dt) * damping;
+        Store4(vx + i, velocityX);
+        Store4(vy + i, velocityY);
+        Store4(px + i, Load4(px + i) + velocityX * dt);
+        Store4(py + i, Load4(py + i) + velocityY * dt);
+        Store4(life + i, Load4(life + i) - dt);
+    }
+
+    for (int i = 0; i < pool.count;)
+    {
+        if (life[i] > 0.0f)
+        {
+            i++;
+            continue;
+        }
+
+        const int last = --pool.count;
+        px[i] = px[last];
+        py[i] = py[last];
+        vx[i] = vx[last];
+        vy[i] = vy[last];
+        life[i] = life[last];
+        pool.maxLife[i] = pool.maxLife[last];
+        pool.color[i] = pool.color[last];
+    }
+}
+
+// Builds a shrinking, fading quad per live particle and draws them all in one call
+void DrawParticles(ParticlePool& pool)
+{
+    if (pool.count == 0) return;
+
+    float* vertices = pool.vertices.data();
+    Color* colors = pool.vertexColors.data();
+    for (int i = 0; i < pool.count; i++)
+    {
+        const float t = pool.life[i] / pool.maxLife[i];
+        const float half = fmaxf(0.5f, pool.size * t);
+        Color color = pool.color[i];
+        color.a = (unsigned char)(color.a * t);
+        PushQuad(vertices + i * 18, colors + i * 6, pool.px[i] - half, pool.py[i] - half, pool.px[i] + half, pool.py[i] + half, color);
+    }
+
+    UpdateGeometryPositions(pool.geometry, vertices, 0, pool.count * 6);
+    UpdateGeometryColors(pool.geometry, colors, 0, pool.count * 6);
+    DrawGeometryBuffer(pool.geometry, 0, pool.count * 6);
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "Math.h"
+#include <vector>
 
 struct Rigidbody
 {
@@ -9,6 +10,7 @@ struct Rigidbody
 
 // v2 = v1 + a(t)
 // p2 = p1 + v2(t) + 0.5a(t^2)
+// NOTE: Single-body helper; PhysicsWorld below takes the integration scheme as a policy
 Vector2 Integrate(const Vector2& pos, Rigidbody& rb, float dt)
 {
     rb.vel = rb.vel + rb.acc * dt;
@@ -37,4 +39,130 @@ Vector2 Seek(
 {
     Vector2 desiredVelocity = Normalize(targetPosition - seekerPosition) * maxSpeed;
     return desiredVelocity - seekerVelocity;
-}
\ No newline at end of file
+}
+
+//----------------------------------------------------------------------------------
+// Integrator policies
+//----------------------------------------------------------------------------------
+// Each policy advances one body by dt. accel(position, velocity) returns the acceleration
+// at that state, so the policy decides where and how often forces are sampled.
+// Start is called once per body before its first Step.
+
+// v2 = v1 + a(p1, v1)t
+// p2 = p1 + v2(t)
+struct SemiImplicitEuler
+{
+    template<typename Acceleration>
+    static void Start(const Vector2& pos, Rigidbody& rb, Acceleration& accel) {}
+
+    template<typename Acceleration>
+    static void Step(Vector2& pos, Rigidbody& rb, float dt, Acceleration& accel)
+    {
+        rb.acc = accel(pos, rb.vel);
+        rb.vel = rb.vel + rb.acc * dt;
+        pos = pos + rb.vel * dt;
+    }
+};
+
+// p2 = p1 + v1(t) + 0.5a1(t^2)
+// v2 = v1 + 0.5(a1 + a2)t
+// a1 is carried over in rb.acc, so there is one force evaluation per step
+// NOTE: Velocity-dependent forces are sampled with v1
+struct VelocityVerlet
+{
+    template<typename Acceleration>
+    static void Start(const Vector2& pos, Rigidbody& rb, Acceleration& accel)
+    {
+        rb.acc = accel(pos, rb.vel);
+    }
+
+    template<typename Acceleration>
+    static void Step(Vector2& pos, Rigidbody& rb, float dt, Acceleration& accel)
+    {
+        pos = pos + rb.vel * dt + rb.acc * (0.5f * dt * dt);
+        Vector2 acc = accel(pos, rb.vel);
+        rb.vel = rb.vel + (rb.acc + acc) * (0.5f * dt);
+        rb.acc = acc;
+    }
+};
+
+// Drift-kick-drift leapfrog
+// p = p1 + v1(t/2)
+// v2 = v1 + a(p, v1)t
+// p2 = p + v2(t/2)
+struct PositionVerlet
+{
+    template<typename Acceleration>
+    static void Start(const Vector2& pos, Rigidbody& rb, Acceleration& accel) {}
+
+    template<typename Acceleration>
+    static void Step(Vector2& pos, Rigidbody& rb, float dt, Acceleration& accel)
+    {
+        const float halfDt = 0.5f * dt;
+        pos = pos + rb.vel * halfDt;
+        rb.acc = accel(pos, rb.vel);
+        rb.vel = rb.vel + rb.acc * dt;
+        pos = pos + rb.vel * halfDt;
+    }
+};
+
+// Classic 4th order Runge-Kutta, four force evaluations per step
+struct RK4
+{
+    template<typename Acceleration>
+    static void Start(const Vector2& pos, Rigidbody& rb, Acceleration& accel) {}
+
+    template<typename Acceleration>
+    static void Step(Vector2& pos, Rigidbody& rb, float dt, Acceleration& accel)
+    {
+        const float halfDt = 0.5f * dt;
+
+        const Vector2 p1 = pos, v1 = rb.vel;
+        const Vector2 a1 = accel(p1, v1);
+        const Vector2 p2 = p1 + v1 * halfDt, v2 = v1 + a1 * halfDt;
+        const Vector2 a2 = accel(p2, v2);
+        const Vector2 p3 = p1 + v2 * halfDt, v3 = v1 + a2 * halfDt;
+        const Vector2 a3 = accel(p3, v3);
+        const Vector2 p4 = p1 + v3 * dt, v4 = v1 + a3 * dt;
+        const Vector2 a4 = accel(p4, v4);
+
+        const float sixthDt = dt / 6.0f;
+        pos = p1 + (v1 + (v2 + v3) * 2.0f + v4) * sixthDt;
+        rb.vel = v1 + (a1 + (a2 + a3) * 2.0f + a4) * sixthDt;
+        rb.acc = (a1 + (a2 + a3) * 2.0f + a4) * (1.0f / 6.0f);
+    }
+};
+
+// Bodies integrated with a compile-time integrator, e.g. PhysicsWorld<VelocityVerlet>
+template<typename Integrator>
+struct PhysicsWorld
+{
+    std::vector<Vector2> positions;
+    std::vector<Rigidbody> bodies;
+    size_t started = 0;     // bodies [started, size) still need Integrator::Start
+};
+
+template<typename Integrator>
+void AddBody(PhysicsWorld<Integrator>& world, Vector2 position, Vector2 velocity)
+{
+    Rigidbody rb;
+    rb.vel = velocity;
+    world.positions.push_back(position);
+    world.bodies.push_back(rb);
+}
+
+// Advances every body by dt, accel(position, velocity) -> acceleration
+template<typename Integrator, typename Acceleration>
+void Step(PhysicsWorld<Integrator>& world, float dt, Acceleration accel)
+{
+    const size_t count = world.bodies.size();
+    Vector2* positions = world.positions.data();
+    Rigidbody* bodies = world.bodies.data();
+
+    for (size_t i = world.started; i < count; i++)
+        Integrator::Start(positions[i], bodies[i], accel);
+    world.started = count;
+
+    for (size_t i = 0; i < count; i++)
+        Integrator::Step(positions[i], bodies[i], dt, accel);
+}
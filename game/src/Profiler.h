@@ -0,0 +1,429 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Scoped CPU profiler
+// PROFILE_ZONE("name") times the rest of the enclosing scope. Each thread writes finished zones
+// to its own ring buffer, so recording is two timestamps and a store with no locks. Once per
+// frame ProfilerNextFrame drains every ring into a history of frames for the ImGui panel in
+// ProfilerPanel.h. Names must be string literals or otherwise outlive the profiler.
+// StartTraceCapture records frames for offline analysis as a Chrome trace (see below).
+// Build with PROFILER_ENABLED=0 (premake --profiler=off) to compile every zone out.
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+// rdtsc is far cheaper than the OS clock; it's converted using a rate measured against
+// steady_clock, which assumes an invariant TSC like every x64 CPU of the last decade has
+#if defined(_M_X64) || defined(__x86_64__)
+#define PROFILER_RDTSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#define PROFILER_RDTSC 0
+#endif
+
+// A finished zone, or a counter sample when depth is profileCounter
+struct ProfileEvent
+{
+    const char* name;
+    uint64_t start;         // ProfilerTimestamp ticks
+    union
+    {
+        uint64_t end;       // zones
+        double value;       // counters
+    };
+    uint16_t thread;        // index into Profiler::threads
+    uint16_t depth;         // 0 for outermost zones
+};
+
+const uint16_t profileCounter = 0xFFFF;
+
+// Ring of finished zones, written only by its thread
+struct ProfilerThread
+{
+    char name[32];
+    std::vector<ProfileEvent> events;
+    std::atomic<uint64_t> head{ 0 };    // events ever written
+    uint64_t read = 0;                  // events drained by ProfilerNextFrame
+    int depth = 0;
+};
+
+struct ProfileFrame
+{
+    uint64_t start = 0, end = 0;
+    std::vector<ProfileEvent> events;   // zones that ended during the frame
+};
+
+struct Profiler
+{
+    std::mutex threadsMutex;            // guards registration only
+    std::vector<std::unique_ptr<ProfilerThread>> threads;
+
+    std::vector<ProfileFrame> frames;   // ring of the most recent frames
+    size_t head = 0;                    // slot the next frame is written to
+    size_t count = 0;
+    uint64_t frameStart = 0;
+    uint64_t droppedEvents = 0;         // lost because a thread wrote more than its ring holds in a frame
+    bool paused = false;                // stops recording so history can be inspected
+
+    // Trace capture, written out by traceWriter so the frames being measured aren't disturbed
+    bool capturing = false;
+    int captureFramesLeft = 0;          // 0 = until StopTraceCapture
+    std::string capturePath;
+    std::vector<ProfileEvent> captureEvents;
+    std::vector<uint64_t> captureFrameStarts;
+    std::thread traceWriter;
+    std::atomic<bool> traceWriting{ false };
+
+    // Calibration of ticks against steady_clock
+    uint64_t calibrationTicks = 0;
+    std::chrono::steady_clock::time_point calibrationTime;
+    double ticksPerSecond = 1e9;
+};
+
+const int profilerEventsPerThread = 1 << 16;
+const int profilerFrameHistory = 300;
+
+uint64_t ProfilerTimestamp()
+{
+#if PROFILER_RDTSC
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+Profiler& GetProfiler()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+thread_local ProfilerThread* profilerThread = nullptr;
+
+// Names the calling thread in the panel; threads that don't call this are named by index
+void ProfilerRegisterThread(const char* name)
+{
+    Profiler& profiler = GetProfiler();
+    std::lock_guard<std::mutex> lock(profiler.threadsMutex);
+    if (profilerThread == nullptr)
+    {
+        profiler.threads.emplace_back(new ProfilerThread);
+        profilerThread = profiler.threads.back().get();
+        profilerThread->events.resize(profilerEventsPerThread);
+    }
+    if (name != nullptr)
+        snprintf(profilerThread->name, sizeof(profilerThread->name), "%s", name);
+    else
+        snprintf(profilerThread->name, sizeof(profilerThread->name), "Thread %d", (int)profiler.threads.size() - 1);
+}
+
+ProfilerThread& GetProfilerThread()
+{
+    if (profilerThread == nullptr) ProfilerRegisterThread(nullptr);
+    return *profilerThread;
+}
+
+void ProfilerRecord(ProfilerThread& thread, const char* name, uint64_t start, uint64_t end, int depth)
+{
+    const uint64_t head = thread.head.load(std::memory_order_relaxed);
+    ProfileEvent& event = thread.events[head & (profilerEventsPerThread - 1)];
+    event.name = name;
+    event.start = start;
+    event.end = end;
+    event.depth = (uint16_t)depth;
+    thread.head.store(head + 1, std::memory_order_release);
+}
+
+void ProfilerCounter(const char* name, double value)
+{
+    ProfilerThread& thread = GetProfilerThread();
+    const uint64_t head = thread.head.load(std::memory_order_relaxed);
+    ProfileEvent& event = thread.events[head & (profilerEventsPerThread - 1)];
+    event.name = name;
+    event.start = ProfilerTimestamp();
+    event.value = value;
+    event.depth = profileCounter;
+    thread.head.store(head + 1, std::memory_order_release);
+}
+
+struct ProfileZone
+{
+    const char* name;
+    uint64_t start;
+    ProfilerThread& thread;
+
+    explicit ProfileZone(const char* zoneName) : name(zoneName), thread(GetProfilerThread())
+    {
+        thread.depth++;
+        start = ProfilerTimestamp();
+    }
+
+    ~ProfileZone()
+    {
+        const uint64_t end = ProfilerTimestamp();
+        thread.depth--;
+        ProfilerRecord(thread, name, start, end, thread.depth);
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+double ProfilerSeconds(uint64_t ticks)
+{
+    return ticks / GetProfiler().ticksPerSecond;
+}
+
+void StopTraceCapture();
+
+// Closes the current frame: moves every zone finished since the last call into the history
+// Call once per frame from one thread, typically the render thread
+void ProfilerNextFrame()
+{
+    Profiler& profiler = GetProfiler();
+    const uint64_t now = ProfilerTimestamp();
+
+#if PROFILER_RDTSC
+    const std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+    if (profiler.calibrationTicks == 0)
+    {
+        profiler.calibrationTicks = now;
+        profiler.calibrationTime = time;
+    }
+    else
+    {
+        // The longer the baseline, the more accurate the rate
+        const double seconds = std::chrono::duration<double>(time - profiler.calibrationTime).count();
+        if (seconds > 0.1) profiler.ticksPerSecond = (now - profiler.calibrationTicks) / seconds;
+    }
+#else
+    profiler.ticksPerSecond = (double)std::chrono::steady_clock::period::den / std::chrono::steady_clock::period::num;
+#endif
+
+    ProfileFrame* frame = nullptr;
+    if (!profiler.paused && profiler.frameStart != 0)
+    {
+        if (profiler.frames.empty()) profiler.frames.resize(profilerFrameHistory);
+        frame = &profiler.frames[profiler.head];
+        frame->start = profiler.frameStart;
+        frame->end = now;
+        frame->events.clear();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(profiler.threadsMutex);
+        for (size_t t = 0; t < profiler.threads.size(); t++)
+        {
+            ProfilerThread& thread = *profiler.threads[t];
+            const uint64_t head = thread.head.load(std::memory_order_acquire);
+
+            // Keep clear of the slots the writer may be overwriting right now
+            if (head - thread.read > profilerEventsPerThread / 2)
+            {
+                profiler.droppedEvents += head - profilerEventsPerThread / 2 - thread.read;
+                thread.read = head - profilerEventsPerThread / 2;
+            }
+
+            // While paused and not capturing the events are still drained, just not kept
+            for (; (frame != nullptr || profiler.capturing) && thread.read < head; thread.read++)
+            {
+                ProfileEvent event = thread.events[thread.read & (profilerEventsPerThread - 1)];
+                event.thread = (uint16_t)t;
+                if (frame != nullptr) frame->events.push_back(event);
+                if (profiler.capturing) profiler.captureEvents.push_back(event);
+            }
+            thread.read = head;
+        }
+    }
+
+    if (frame != nullptr)
+    {
+        profiler.head = (profiler.head + 1) % profiler.frames.size();
+        profiler.count = std::min(profiler.count + 1, profiler.frames.size());
+    }
+    profiler.frameStart = now;
+
+    if (profiler.capturing)
+    {
+        profiler.captureFrameStarts.push_back(now);
+        if (profiler.captureFramesLeft > 0 && --profiler.captureFramesLeft == 0)
+            StopTraceCapture();
+    }
+}
+
+// Frame recorded framesBack frames ago (0 = most recent), or null
+const ProfileFrame* GetProfileFrame(size_t framesBack)
+{
+    const Profiler& profiler = GetProfiler();
+    if (framesBack >= profiler.count) return nullptr;
+    return &profiler.frames[(profiler.head + profiler.frames.size() - 1 - framesBack) % profiler.frames.size()];
+}
+
+//----------------------------------------------------------------------------------
+// Trace capture
+//----------------------------------------------------------------------------------
+// Writes Chrome Trace Event JSON, which chrome://tracing and ui.perfetto.dev both open:
+// zones as complete events, counters as counter tracks, thread names as metadata and frame
+// boundaries as global instant events. Timestamps are microseconds from the capture start.
+
+struct TraceCapture
+{
+    std::string path;
+    double ticksPerSecond;
+    std::vector<std::string> threadNames;
+    std::vector<ProfileEvent> events;
+    std::vector<uint64_t> frameStarts;
+};
+
+// Names are code literals, but escape them anyway so the file always parses
+void WriteJsonString(FILE* file, const char* text)
+{
+    fputc('"', file);
+    for (const char* c = text; *c; c++)
+    {
+        if (*c == '"' || *c == '\\') fputc('\\', file);
+        if ((unsigned char)*c >= 0x20) fputc(*c, file);
+    }
+    fputc('"', file);
+}
+
+void WriteChromeTrace(TraceCapture capture)
+{
+    FILE* file = fopen(capture.path.c_str(), "w");
+    if (file == nullptr)
+    {
+        printf("profiler: failed to open %s\n", capture.path.c_str());
+        GetProfiler().traceWriting.store(false);
+        return;
+    }
+
+    const uint64_t origin = capture.frameStarts.empty() ? 0 : capture.frameStarts.front();
+    const double microseconds = 1e6 / capture.ticksPerSecond;
+    auto timestamp = [&](uint64_t ticks) { return ((double)ticks - (double)origin) * microseconds; };
+
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Sunshine\"}}");
+    for (size_t t = 0; t < capture.threadNames.size(); t++)
+    {
+        fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", (int)t);
+        WriteJsonString(file, capture.threadNames[t].c_str());
+        fprintf(file, "}}");
+    }
+
+    for (size_t f = 0; f < capture.frameStarts.size(); f++)
+        fprintf(file, ",\n{\"name\":\"Frame %d\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%.3f}", (int)f, timestamp(capture.frameStarts[f]));
+
+    for (const ProfileEvent& event : capture.events)
+    {
+        fprintf(file, ",\n{\"name\":");
+        WriteJsonString(file, event.name);
+        if (event.depth == profileCounter)
+            fprintf(file, ",\"ph\":\"C\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"value\":%.17g}}", event.thread, timestamp(event.start), event.value);
+        else
+            fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}", event.thread, timestamp(event.start), (event.end - event.start) * microseconds);
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    GetProfiler().traceWriting.store(false);
+}
+
+// Fills in what every capture shares and hands it to traceWriter
+// One trace is written at a time; starting another waits for the previous one to finish.
+void WriteTraceInBackground(TraceCapture& capture)
+{
+    Profiler& profiler = GetProfiler();
+    capture.ticksPerSecond = profiler.ticksPerSecond;
+    {
+        std::lock_guard<std::mutex> lock(profiler.threadsMutex);
+        for (const std::unique_ptr<ProfilerThread>& thread : profiler.threads)
+            capture.threadNames.push_back(thread->name);
+    }
+
+    if (profiler.traceWriter.joinable()) profiler.traceWriter.join();
+    profiler.traceWriting.store(true);
+    profiler.traceWriter = std::thread(WriteChromeTrace, std::move(capture));
+}
+
+// Records every zone and counter from the next frame boundary for frameCount frames,
+// or until StopTraceCapture if frameCount is 0, then writes them to path
+void StartTraceCapture(const char* path, int frameCount)
+{
+    Profiler& profiler = GetProfiler();
+    if (profiler.capturing) return;
+    profiler.capturing = true;
+    profiler.captureFramesLeft = frameCount;
+    profiler.capturePath = path;
+    profiler.captureEvents.clear();
+    profiler.captureFrameStarts.clear();
+    profiler.captureFrameStarts.push_back(profiler.frameStart != 0 ? profiler.frameStart : ProfilerTimestamp());
+}
+
+// Hands the capture to a background thread to write; call from the thread that calls ProfilerNextFrame
+void StopTraceCapture()
+{
+    Profiler& profiler = GetProfiler();
+    if (!profiler.capturing) return;
+    profiler.capturing = false;
+
+    TraceCapture capture;
+    capture.path = profiler.capturePath;
+    capture.events.swap(profiler.captureEvents);
+    capture.frameStarts.swap(profiler.captureFrameStarts);
+    WriteTraceInBackground(capture);
+}
+
+// Writes the last frameCount frames of the history, e.g. when a hitch has just happened
+// Call from the thread that calls ProfilerNextFrame
+void DumpProfileHistory(const char* path, int frameCount)
+{
+    Profiler& profiler = GetProfiler();
+    if (profiler.count == 0) return;
+
+    TraceCapture capture;
+    capture.path = path;
+    for (int f = std::min(frameCount, (int)profiler.count) - 1; f >= 0; f--)
+    {
+        const ProfileFrame& frame = *GetProfileFrame(f);
+        capture.frameStarts.push_back(frame.start);
+        capture.events.insert(capture.events.end(), frame.events.begin(), frame.events.end());
+    }
+    WriteTraceInBackground(capture);
+}
+
+// Flushes any capture in progress and waits for it to be written; call before exiting
+void ProfilerShutdown()
+{
+    Profiler& profiler = GetProfiler();
+    StopTraceCapture();
+    if (profiler.traceWriter.joinable()) profiler.traceWriter.join();
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILER_ENABLED
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_THREAD(name) ProfilerRegisterThread(name)
+#define PROFILE_FRAME() ProfilerNextFrame()
+#define PROFILE_COUNTER(name, value) ProfilerCounter(name, (double)(value))
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_THREAD(name)
+#define PROFILE_FRAME()
+#define PROFILE_COUNTER(name, value)
+#endif
@@ -0,0 +1,219 @@
+#pragma once
+#include "imgui.h"
+#include "Profiler.h"
+#include "Arena.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+// ImGui window for the profiler: frame time history with pause and scrub, a flame graph of
+// the selected frame with one lane per thread, and per-zone min/avg/max over the history
+
+struct ZoneStats
+{
+    const char* name;
+    double min, max, total;     // seconds per frame
+    int frames;                 // frames the zone appeared in
+    int calls;
+};
+
+struct ProfilerPanel
+{
+    int framesBack = 0;         // selected frame, 0 = most recent
+    std::vector<float> frameTimes;
+    std::vector<ZoneStats> stats;
+    std::vector<double> frameTotals;
+};
+
+// Stable colour per zone name
+ImU32 ZoneColor(const char* name)
+{
+    uint32_t hash = 2166136261u;
+    for (const char* c = name; *c; c++)
+        hash = (hash ^ (unsigned char)*c) * 16777619u;
+    return IM_COL32(80 + (hash & 127), 80 + ((hash >> 8) & 127), 80 + ((hash >> 16) & 127), 255);
+}
+
+// Lane layout is allocated from scratch
+void DrawFlameGraph(const ProfileFrame& frame, Arena& scratch)
+{
+    const float rowHeight = 18.0f;
+    const float labelWidth = 90.0f;
+    const ImU32 textColor = IM_COL32(0, 0, 0, 255);
+    const ImU32 laneColor = IM_COL32(255, 255, 255, 255);
+
+    // One lane per thread, as deep as its deepest zone
+    size_t laneCount = 0;
+    for (const ProfileEvent& event : frame.events)
+        if (event.depth != profileCounter) laneCount = std::max<size_t>(laneCount, event.thread + 1);
+    int* laneDepth = ArenaArray<int>(scratch, laneCount);
+    float* laneY = ArenaArray<float>(scratch, laneCount + 1);
+    std::fill(laneDepth, laneDepth + laneCount, 0);
+    for (const ProfileEvent& event : frame.events)
+    {
+        if (event.depth == profileCounter) continue;
+        laneDepth[event.thread] = std::max(laneDepth[event.thread], event.depth + 1);
+    }
+    laneY[0] = 0.0f;
+    for (size_t t = 0; t < laneCount; t++)
+        laneY[t + 1] = laneY[t] + std::max(laneDepth[t], 1) * rowHeight + 4.0f;
+
+    ImDrawList* draw = ImGui::GetWindowDrawList();
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float width = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 100.0f);
+    const double frameTicks = (double)std::max<uint64_t>(frame.end - frame.start, 1);
+
+    {
+        Profiler& profiler = GetProfiler();
+        std::lock_guard<std::mutex> lock(profiler.threadsMutex);
+        for (size_t t = 0; t < laneCount && t < profiler.threads.size(); t++)
+            draw->AddText(ImVec2(origin.x, origin.y + laneY[t]), laneColor, profiler.threads[t]->name);
+    }
+
+    const ProfileEvent* hovered = nullptr;
+    for (const ProfileEvent& event : frame.events)
+    {
+        if (event.depth == profileCounter) continue;
+
+        // Zones that started in an earlier frame are clipped to this one
+        const double start = std::max((double)event.start - (double)frame.start, 0.0) / frameTicks;
+        const double end = std::min((double)event.end - (double)frame.start, frameTicks) / frameTicks;
+        const ImVec2 min(origin.x + labelWidth + (float)start * width, origin.y + laneY[event.thread] + event.depth * rowHeight);
+        const ImVec2 max(std::max(origin.x + labelWidth + (float)end * width, min.x + 1.0f), min.y + rowHeight - 1.0f);
+        draw->AddRectFilled(min, max, ZoneColor(event.name));
+
+        if (max.x - min.x > ImGui::CalcTextSize(event.name).x + 4.0f)
+            draw->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), textColor, event.name);
+        if (ImGui::IsMouseHoveringRect(min, max))
+            hovered = &event;
+    }
+
+    ImGui::Dummy(ImVec2(labelWidth + width, laneY[laneCount]));
+
+    if (hovered != nullptr)
+    {
+        ImGui::BeginTooltip();
+        ImGui::Text("%s: %.3f ms", hovered->name, ProfilerSeconds(hovered->end - hovered->start) * 1000.0);
+        ImGui::EndTooltip();
+    }
+}
+
+// Totals each zone per frame, then min/avg/max of those totals over the recorded frames
+void UpdateZoneStats(ProfilerPanel& panel)
+{
+    panel.stats.clear();
+    const Profiler& profiler = GetProfiler();
+    for (size_t f = 0; f < profiler.count; f++)
+    {
+        const ProfileFrame& frame = *GetProfileFrame(f);
+        panel.frameTotals.assign(panel.stats.size(), -1.0);
+        for (const ProfileEvent& event : frame.events)
+        {
+            if (event.depth == profileCounter) continue;
+            size_t i = 0;
+            while (i < panel.stats.size() && panel.stats[i].name != event.name) i++;
+            if (i == panel.stats.size())
+            {
+                panel.stats.push_back(ZoneStats{ event.name, 1e30, 0.0, 0.0, 0, 0 });
+                panel.frameTotals.push_back(-1.0);
+            }
+            panel.frameTotals[i] = std::max(panel.frameTotals[i], 0.0) + ProfilerSeconds(event.end - event.start);
+            panel.stats[i].calls++;
+        }
+
+        for (size_t i = 0; i < panel.stats.size(); i++)
+        {
+            const double seconds = panel.frameTotals[i];
+            if (seconds < 0.0) continue;
+            ZoneStats& zone = panel.stats[i];
+            zone.min = std::min(zone.min, seconds);
+            zone.max = std::max(zone.max, seconds);
+            zone.total += seconds;
+            zone.frames++;
+        }
+    }
+
+    std::sort(panel.stats.begin(), panel.stats.end(), [](const ZoneStats& a, const ZoneStats& b)
+        {
+            return a.total / a.frames > b.total / b.frames;
+        });
+}
+
+void DrawProfilerWindow(ProfilerPanel& panel, bool* open, Arena& scratch)
+{
+    ImGui::SetNextWindowSize(ImVec2(720.0f, 480.0f), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Profiler", open))
+    {
+        ImGui::End();
+        return;
+    }
+
+#if !PROFILER_ENABLED
+    ImGui::TextUnformatted("Compiled out, build with PROFILER_ENABLED=1");
+#else
+    Profiler& profiler = GetProfiler();
+    ImGui::Checkbox("Pause", &profiler.paused);
+    ImGui::SameLine();
+    if (profiler.count > 0)
+    {
+        panel.framesBack = std::min(panel.framesBack, (int)profiler.count - 1);
+        ImGui::SliderInt("Frames back", &panel.framesBack, (int)profiler.count - 1, 0);
+    }
+
+    if (profiler.capturing)
+    {
+        if (ImGui::Button("Stop capture")) StopTraceCapture();
+        ImGui::SameLine();
+        ImGui::Text("Capturing to %s", profiler.capturePath.c_str());
+    }
+    else if (profiler.traceWriting.load())
+        ImGui::TextUnformatted("Writing trace");
+    else if (ImGui::Button("Capture 300 frames"))
+        StartTraceCapture("sunshine.trace.json", 300);
+
+    if (profiler.droppedEvents > 0)
+        ImGui::Text("%llu events dropped", (unsigned long long)profiler.droppedEvents);
+
+    // Oldest to newest, like the scrub slider
+    panel.frameTimes.resize(profiler.count);
+    for (size_t f = 0; f < profiler.count; f++)
+    {
+        const ProfileFrame& frame = *GetProfileFrame(profiler.count - 1 - f);
+        panel.frameTimes[f] = (float)(ProfilerSeconds(frame.end - frame.start) * 1000.0);
+    }
+    ImGui::PlotHistogram("##frames", panel.frameTimes.data(), (int)panel.frameTimes.size(), 0, "Frame ms", 0.0f, 33.3f,
+        ImVec2(ImGui::GetContentRegionAvail().x, 60.0f));
+
+    const ProfileFrame* frame = GetProfileFrame(panel.framesBack);
+    if (frame != nullptr)
+    {
+        ImGui::Text("Frame %d back: %.3f ms, %d zones", panel.framesBack,
+            ProfilerSeconds(frame->end - frame->start) * 1000.0, (int)frame->events.size());
+        DrawFlameGraph(*frame, scratch);
+    }
+
+    ImGui::Separator();
+    UpdateZoneStats(panel);
+    if (ImGui::BeginTable("zones", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY))
+    {
+        ImGui::TableSetupColumn("Zone");
+        ImGui::TableSetupColumn("Min ms");
+        ImGui::TableSetupColumn("Avg ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableSetupColumn("Calls/frame");
+        ImGui::TableHeadersRow();
+        for (const ZoneStats& zone : panel.stats)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(zone.name);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.min * 1000.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.total / zone.frames * 1000.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", zone.max * 1000.0);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", (double)zone.calls / zone.frames);
+        }
+        ImGui::EndTable();
+    }
+#endif
+
+    ImGui::End();
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "raylib.h"
+#include "Collision.h"
+#include <vector>
+
+// Fixed-capacity projectile pool stored structure-of-arrays
+// Every tick each projectile is swept from its previous to its new position against the
+// obstacle grid, so fast projectiles can't tunnel through thin obstacles.
+
+struct HitEvent
+{
+    Vector2 position;
+    Vector2 velocity;
+    int obstacle;
+};
+
+struct ProjectilePool
+{
+    int capacity = 0;
+    int count = 0;
+    std::vector<float> px, py;
+    std::vector<float> vx, vy;
+    std::vector<float> life;            // seconds remaining
+
+    // Hits from the latest StepProjectiles; extra hits past capacity are counted and dropped
+    std::vector<HitEvent> hits;
+    int hitCount = 0;
+    int droppedHits = 0;
+};
+
+void InitProjectiles(ProjectilePool& pool, int capacity, int hitCapacity)
+{
+    pool.capacity = capacity;
+    pool.count = 0;
+    std::vector<float>* arrays[] = { &pool.px, &pool.py, &pool.vx, &pool.vy, &pool.life };
+    for (std::vector<float>* array : arrays)
+        array->assign(capacity, 0.0f);
+    pool.hits.resize(hitCapacity);
+    pool.hitCount = 0;
+    pool.droppedHits = 0;
+}
+
+// Returns false when the pool is full
+bool SpawnProjectile(ProjectilePool& pool, Vector2 position, Vector2 velocity, float life)
+{
+    if (pool.count == pool.capacity) return false;
+    const int i = pool.count++;
+    pool.px[i] = position.x;
+    pool.py[i] = position.y;
+    pool.vx[i] = velocity.x;
+    pool.vy[i] = velocity.y;
+    pool.life[i] = life;
+    return true;
+}
+
+void RemoveProjectile(ProjectilePool& pool, int i)
+{
+    const int last = --pool.count;
+    pool.px[i] = pool.px[last];
+    pool.py[i] = pool.py[last];
+    pool.vx[i] = pool.vx[last];
+    pool.vy[i] = pool.vy[last];
+    pool.life[i] = pool.life[last];
+}
+
+// Moves every projectile, records the ones that hit an obstacle and removes them along
+// with the ones whose lifetime ran out
+void StepProjectiles(ProjectilePool& pool, const ObstacleGrid& grid, const std::vector<Rectangle>& obstacles, float dt)
+{
+    pool.hitCount = 0;
+    pool.droppedHits = 0;
+
+    for (int i = 0; i < pool.count;)
+    {
+        const Vector2 start{ pool.px[i], pool.py[i] };
+        const Vector2 velocity{ pool.vx[i], pool.vy[i] };
+        const Vector2 end = start + velocity * dt;
+
+        Vector2 poi;
+        const int obstacle = Raycast(grid, obstacles, start, end, poi);
+        if (obstacle >= 0)
+        {
+            if (pool.hitCount < (int)pool.hits.size())
+                pool.hits[pool.hitCount++] = HitEvent{ poi, velocity, obstacle };
+            else
+                pool.droppedHits++;
+            RemoveProjectile(pool, i);
+            continue;
+        }
+
+        pool.life[i] -= dt;
+        if (pool.life[i] <= 0.0f)
+        {
+            RemoveProjectile(pool, i);
+            continue;
+        }
+
+        pool.px[i] = end.x;
+        pool.py[i] = end.y;
+        i++;
+    }
+}
@@ -0,0 +1,395 @@
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+#include "Math.h"
+#include "Collision.h"
+#include "ObstacleEdit.h"
+#include "Arena.h"
+#include <vector>
+#include <cstdint>
+
+// Triangle list of position + colour vertices in GPU buffers, drawn with rlgl's default shader
+// A whole buffer (or any contiguous range of it) is submitted as a single draw call
+struct GeometryBuffer
+{
+    unsigned int vao = 0;
+    unsigned int positionVbo = 0;   // 3 floats per vertex
+    unsigned int colorVbo = 0;      // 4 unsigned bytes per vertex
+    int capacity = 0;               // vertices
+};
+
+void LoadGeometryBuffer(GeometryBuffer& buffer, int capacity, bool dynamic)
+{
+    int* locs = rlGetShaderLocsDefault();
+    buffer.capacity = capacity;
+    buffer.vao = rlLoadVertexArray();
+    rlEnableVertexArray(buffer.vao);
+
+    buffer.positionVbo = rlLoadVertexBuffer(nullptr, capacity * 3 * sizeof(float), dynamic);
+    rlSetVertexAttribute(locs[RL_SHADER_LOC_VERTEX_POSITION], 3, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(locs[RL_SHADER_LOC_VERTEX_POSITION]);
+
+    buffer.colorVbo = rlLoadVertexBuffer(nullptr, capacity * sizeof(Color), dynamic);
+    rlSetVertexAttribute(locs[RL_SHADER_LOC_VERTEX_COLOR], 4, RL_UNSIGNED_BYTE, true, 0, 0);
+    rlEnableVertexAttribute(locs[RL_SHADER_LOC_VERTEX_COLOR]);
+
+    rlDisableVertexArray();
+}
+
+void UnloadGeometryBuffer(GeometryBuffer& buffer)
+{
+    rlUnloadVertexArray(buffer.vao);
+    rlUnloadVertexBuffer(buffer.positionVbo);
+    rlUnloadVertexBuffer(buffer.colorVbo);
+    buffer = GeometryBuffer{};
+}
+
+// positions holds 3 floats per vertex
+void UpdateGeometryPositions(GeometryBuffer& buffer, const float* positions, int firstVertex, int vertexCount)
+{
+    if (vertexCount <= 0) return;
+    rlUpdateVertexBuffer(buffer.positionVbo, positions, vertexCount * 3 * sizeof(float), firstVertex * 3 * sizeof(float));
+}
+
+void UpdateGeometryColors(GeometryBuffer& buffer, const Color* colors, int firstVertex, int vertexCount)
+{
+    if (vertexCount <= 0) return;
+    rlUpdateVertexBuffer(buffer.colorVbo, colors, vertexCount * sizeof(Color), firstVertex * sizeof(Color));
+}
+
+// Draws rangeCount vertex ranges [firstVertices[i], firstVertices[i] + vertexCounts[i]) with the
+// current rlgl transform, setting up the shader once for all of them
+void DrawGeometryBufferRanges(const GeometryBuffer& buffer, const int* firstVertices, const int* vertexCounts, int rangeCount)
+{
+    if (rangeCount <= 0) return;
+
+    // Flush whatever raylib has batched so far to keep draw order
+    rlDrawRenderBatchActive();
+
+    int* locs = rlGetShaderLocsDefault();
+    const Matrix mvp = Multiply(Multiply(rlGetMatrixTransform(), rlGetMatrixModelview()), rlGetMatrixProjection());
+    const float white[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    rlEnableShader(rlGetShaderIdDefault());
+    rlSetUniformMatrix(locs[RL_SHADER_LOC_MATRIX_MVP], mvp);
+    rlSetUniform(locs[RL_SHADER_LOC_COLOR_DIFFUSE], white, RL_SHADER_UNIFORM_VEC4, 1);
+    rlActiveTextureSlot(0);
+    rlEnableTexture(rlGetTextureIdDefault());
+
+    rlEnableVertexArray(buffer.vao);
+    for (int i = 0; i < rangeCount; i++)
+    {
+        if (vertexCounts[i] > 0) rlDrawVertexArray(firstVertices[i], vertexCounts[i]);
+    }
+    rlDisableVertexArray();
+
+    rlDisableTexture();
+    rlDisableShader();
+}
+
+// Draws vertices [firstVertex, firstVertex + vertexCount) with the current rlgl transform
+void DrawGeometryBuffer(const GeometryBuffer& buffer, int firstVertex, int vertexCount)
+{
+    if (vertexCount <= 0) return;
+    DrawGeometryBufferRanges(buffer, &firstVertex, &vertexCount, 1);
+}
+
+// Appends the two triangles of an axis-aligned quad, in the same winding raylib uses for rectangles
+void PushQuad(float* positions, Color* colors, float x0, float y0, float x1, float y1, Color color)
+{
+    const float quad[18] = {
+        x0, y0, 0.0f,   x0, y1, 0.0f,   x1, y0, 0.0f,
+        x1, y0, 0.0f,   x0, y1, 0.0f,   x1, y1, 0.0f,
+    };
+    for (int i = 0; i < 18; i++) positions[i] = quad[i];
+    for (int i = 0; i < 6; i++) colors[i] = color;
+}
+
+// Rectangles that rarely change (obstacles) kept in GPU buffers and drawn with one call
+// Vertices are rebuilt and uploaded only when the caller's version changes. Each rectangle's
+// colour can be changed on its own, which re-uploads just that rectangle's 6 vertex colours.
+// rlgl draws indexed geometry with 16-bit indices, too few for 100k rectangles, so this stays a
+// plain triangle list like GeometryBuffer.
+struct StaticGeometry
+{
+    GeometryBuffer buffer;
+    uint32_t version = ~0u;
+    int count = 0;                  // rectangles
+    Color color = WHITE;            // colour of every rectangle after a rebuild
+    std::vector<Color> tints;       // current colour per rectangle
+    std::vector<float> vertices;    // staging for uploads
+    std::vector<Color> vertexColors;
+};
+
+void UnloadStaticGeometry(StaticGeometry& geometry)
+{
+    if (geometry.buffer.vao != 0) UnloadGeometryBuffer(geometry.buffer);
+    geometry = StaticGeometry{};
+}
+
+// Rebuilds geometry from rectangles if version differs from the one last uploaded
+// Returns true after a rebuild, which resets every rectangle to color
+bool UpdateStaticGeometry(StaticGeometry& geometry, const std::vector<Rectangle>& rectangles, uint32_t version, Color color)
+{
+    if (geometry.version == version) return false;
+
+    const int count = (int)rectangles.size();
+    if (count * 6 > geometry.buffer.capacity)
+    {
+        // Grow with headroom so a few added rectangles don't reallocate every time
+        if (geometry.buffer.vao != 0) UnloadGeometryBuffer(geometry.buffer);
+        LoadGeometryBuffer(geometry.buffer, (count + count / 2 + 64) * 6, false);
+    }
+
+    geometry.vertices.resize(count * 18);
+    geometry.vertexColors.resize(count * 6);
+    geometry.tints.assign(count, color);
+    for (int i = 0; i < count; i++)
+    {
+        const Rectangle& r = rectangles[i];
+        PushQuad(geometry.vertices.data() + i * 18, geometry.vertexColors.data() + i * 6, r.x, r.y, r.x + r.width, r.y + r.height, color);
+    }
+
+    UpdateGeometryPositions(geometry.buffer, geometry.vertices.data(), 0, count * 6);
+    UpdateGeometryColors(geometry.buffer, geometry.vertexColors.data(), 0, count * 6);
+    geometry.count = count;
+    geometry.color = color;
+    geometry.version = version;
+    return true;
+}
+
+// Changes the colour of one rectangle; a no-op if it already has that colour or index is out of range
+void SetStaticGeometryColor(StaticGeometry& geometry, int index, Color color)
+{
+    if (index < 0 || index >= geometry.count) return;
+
+    Color& tint = geometry.tints[index];
+    if (tint.r == color.r && tint.g == color.g && tint.b == color.b && tint.a == color.a) return;
+    tint = color;
+
+    Color* colors = geometry.vertexColors.data() + index * 6;
+    for (int i = 0; i < 6; i++) colors[i] = color;
+    UpdateGeometryColors(geometry.buffer, colors, index * 6, 6);
+}
+
+void DrawStaticGeometry(const StaticGeometry& geometry)
+{
+    DrawGeometryBuffer(geometry.buffer, 0, geometry.count * 6);
+}
+
+const float culledLargeCells = 4.0f;
+
+// StaticGeometry sorted by the ObstacleGrid cell holding each rectangle's top-left corner
+// The rectangles that can overlap a block of cells are then one vertex range per row of cells,
+// so drawing the view costs a few ranges and the rectangles near it, whatever the map size.
+// Rectangles more than culledLargeCells cells across go first, in one range that is always
+// drawn, so a single huge one doesn't widen the search around the view for all the others.
+// Edits (see ObstacleEdit.h) are applied in place: removed rectangles are collapsed to nothing
+// and added ones go after the sorted ones, where they are always drawn, until there are
+// enough of either to be worth re-sorting.
+struct CulledGeometry
+{
+    StaticGeometry geometry;            // large rectangles, the rest in cell order, then any added since
+    ObstacleGridView cells;             // layout of the grid sorted by, without its arrays
+    std::vector<int> cellStart;         // grid width * height + 1 offsets into the sorted rectangles
+    std::vector<int> slots;             // rectangle index -> position in the sorted order
+    std::vector<Rectangle> sorted;
+    Vector2 maxSize{ 0.0f, 0.0f };      // largest rectangle in cell order, how far up and left of the view to look
+    uint32_t version = ~0u;
+    int largeCount = 0;                 // rectangles ahead of the cell order, always drawn
+    int sortedCount = 0;                // large rectangles plus those in cell order
+    int collapsed = 0;                  // removed rectangles still taking up a slot
+
+    // Results of the last DrawCulledGeometry: rectangles in the ranges submitted, which include
+    // some beside the view that the GPU clips, and those left out
+    int candidates = 0;
+    int culled = 0;
+    int ranges = 0;                     // draw calls
+};
+
+void UnloadCulledGeometry(CulledGeometry& culled)
+{
+    UnloadStaticGeometry(culled.geometry);
+    culled = CulledGeometry{};
+}
+
+// Re-sorts and re-uploads rectangles if version differs from the one last uploaded
+// grid must have been built from the same rectangles; returns true after a rebuild
+// Sorting temporaries are allocated from scratch and only needed during the call
+bool UpdateCulledGeometry(CulledGeometry& culled, const ObstacleGrid& grid, const std::vector<Rectangle>& rectangles, uint32_t version, Color color, Arena& scratch)
+{
+    if (culled.version == version) return false;
+
+    // Counting sort by home cell, like BuildObstacleGrid but with one entry per rectangle
+    culled.cells = ObstacleGridView{};
+    culled.cells.origin = grid.origin;
+    culled.cells.cellSize = grid.cellSize;
+    culled.cells.invCellSize = grid.invCellSize;
+    culled.cells.width = grid.width;
+    culled.cells.height = grid.height;
+    const int count = (int)rectangles.size();
+    // Large rectangles get home -1 and are counted into cellStart[0], ahead of every cell
+    int* homes = ArenaArray<int>(scratch, count);
+    culled.cellStart.assign(grid.width * grid.height + 1, 0);
+    culled.maxSize = Vector2{ 0.0f, 0.0f };
+    const float largeSize = culledLargeCells * grid.cellSize;
+    for (int i = 0; i < count; i++)
+    {
+        const Rectangle& r = rectangles[i];
+        if (r.width > largeSize || r.height > largeSize)
+        {
+            homes[i] = -1;
+            culled.cellStart[0]++;
+            continue;
+        }
+        const CellRange range = GetCellRange(grid, Rectangle{ r.x, r.y, 0.0f, 0.0f });
+        homes[i] = range.yMax * grid.width + range.xMax;
+        culled.cellStart[homes[i] + 1]++;
+        culled.maxSize.x = std::max(culled.maxSize.x, r.width);
+        culled.maxSize.y = std::max(culled.maxSize.y, r.height);
+    }
+    culled.largeCount = culled.cellStart[0];
+
+    for (size_t i = 1; i < culled.cellStart.size(); i++)
+        culled.cellStart[i] += culled.cellStart[i - 1];
+
+    culled.slots.resize(count);
+    culled.sorted.resize(count);
+    int* cursor = ArenaArray<int>(scratch, grid.width * grid.height);
+    std::copy(culled.cellStart.begin(), culled.cellStart.end() - 1, cursor);
+    int largeCursor = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const int slot = (homes[i] < 0) ? largeCursor++ : cursor[homes[i]]++;
+        culled.slots[i] = slot;
+        culled.sorted[slot] = rectangles[i];
+    }
+
+    UpdateStaticGeometry(culled.geometry, culled.sorted, version, color);
+    culled.version = version;
+    culled.sortedCount = count;
+    culled.collapsed = 0;
+    return true;
+}
+
+// Applies one edit in place, returns false without changing anything if the geometry should
+// be rebuilt instead: the buffer is out of room or too much of it is unsorted or collapsed
+bool ApplyCulledGeometryEdit(CulledGeometry& culled, const ObstacleEdit& edit, Color color)
+{
+    StaticGeometry& geometry = culled.geometry;
+    const int addedCount = (int)edit.added.size();
+    const int unsorted = geometry.count - culled.sortedCount + addedCount;
+    const int collapsed = culled.collapsed + (int)edit.removed.size();
+    if ((geometry.count + addedCount) * 6 > geometry.buffer.capacity ||
+        unsorted > std::max(256, culled.sortedCount / 8) || collapsed > std::max(256, culled.sortedCount / 4))
+        return false;
+
+    // Slots follow the obstacles' swap-and-pop, so indices keep matching the caller's
+    for (int index : edit.removed)
+    {
+        const int slot = culled.slots[index];
+        float* vertices = geometry.vertices.data() + slot * 18;
+        for (int i = 0; i < 18; i++) vertices[i] = 0.0f;
+        UpdateGeometryPositions(geometry.buffer, vertices, slot * 6, 6);
+        culled.slots[index] = culled.slots.back();
+        culled.slots.pop_back();
+    }
+
+    const int first = geometry.count;
+    geometry.count += addedCount;
+    geometry.vertices.resize(geometry.count * 18);
+    geometry.vertexColors.resize(geometry.count * 6);
+    geometry.tints.resize(geometry.count, color);
+    for (int i = 0; i < addedCount; i++)
+    {
+        const Rectangle& r = edit.added[i];
+        const int slot = first + i;
+        PushQuad(geometry.vertices.data() + slot * 18, geometry.vertexColors.data() + slot * 6, r.x, r.y, r.x + r.width, r.y + r.height, color);
+        culled.slots.push_back(slot);
+    }
+    UpdateGeometryPositions(geometry.buffer, geometry.vertices.data() + first * 18, first * 6, addedCount * 6);
+    UpdateGeometryColors(geometry.buffer, geometry.vertexColors.data() + first * 6, first * 6, addedCount * 6);
+
+    culled.collapsed = collapsed;
+    culled.version = geometry.version = edit.version;
+    return true;
+}
+
+// Brings the geometry up to version by applying edits from log, if log has them all
+// Returns false if UpdateCulledGeometry still needs to rebuild it
+bool EditCulledGeometry(CulledGeometry& culled, const ObstacleEditLog& log, uint32_t version, Color color)
+{
+    while (culled.version != version)
+    {
+        const ObstacleEdit* edit = FindObstacleEdit(log, culled.version);
+        if (edit == nullptr || !ApplyCulledGeometryEdit(culled, *edit, color)) return false;
+    }
+    return true;
+}
+
+// Changes the colour of rectangle index (in the caller's order)
+void SetCulledGeometryColor(CulledGeometry& culled, int index, Color color)
+{
+    if (index < 0 || index >= (int)culled.slots.size()) return;
+    SetStaticGeometryColor(culled.geometry, culled.slots[index], color);
+}
+
+// Draws the large rectangles, those whose home cells can overlap view, in world coordinates,
+// and any added since the last sort. The per-row range lists are allocated from scratch.
+void DrawCulledGeometry(CulledGeometry& culled, Rectangle view, Arena& scratch)
+{
+    const ObstacleGridView& cells = culled.cells;
+    const int unsorted = culled.geometry.count - culled.sortedCount;
+    culled.candidates = 0;
+    culled.culled = culled.geometry.count;
+    culled.ranges = 0;
+    if (culled.geometry.count == 0) return;
+
+    // A rectangle overlapping the view has its top-left corner at most maxSize up and left of it
+    const Rectangle area{ view.x - culled.maxSize.x, view.y - culled.maxSize.y,
+        view.width + culled.maxSize.x, view.height + culled.maxSize.y };
+    CellRange range = GetCellRange(cells, area);
+    if (cells.width == 0 || range.xMin > range.xMax || range.yMin > range.yMax)
+        range.yMax = range.yMin - 1;
+
+    // At most one range per row, plus the large and the unsorted rectangles
+    const int maxRanges = std::max(range.yMax - range.yMin + 1, 0) + 2;
+    int* firstVertices = ArenaArray<int>(scratch, maxRanges);
+    int* vertexCounts = ArenaArray<int>(scratch, maxRanges);
+    int rangeCount = 0;
+    if (culled.largeCount > 0)
+    {
+        firstVertices[rangeCount] = 0;
+        vertexCounts[rangeCount] = culled.largeCount * 6;
+        rangeCount++;
+        culled.candidates += culled.largeCount;
+    }
+    for (int y = range.yMin; y <= range.yMax; y++)
+    {
+        const int first = culled.cellStart[y * cells.width + range.xMin];
+        const int last = culled.cellStart[y * cells.width + range.xMax + 1];
+        if (last == first) continue;
+
+        // Rows that meet end to end, e.g. when the view spans the whole grid width, share a range
+        if (rangeCount > 0 && firstVertices[rangeCount - 1] + vertexCounts[rangeCount - 1] == first * 6)
+            vertexCounts[rangeCount - 1] += (last - first) * 6;
+        else
+        {
+            firstVertices[rangeCount] = first * 6;
+            vertexCounts[rangeCount] = (last - first) * 6;
+            rangeCount++;
+        }
+        culled.candidates += last - first;
+    }
+    if (unsorted > 0)
+    {
+        firstVertices[rangeCount] = culled.sortedCount * 6;
+        vertexCounts[rangeCount] = unsorted * 6;
+        rangeCount++;
+        culled.candidates += unsorted;
+    }
+    culled.culled = culled.geometry.count - culled.candidates;
+    culled.ranges = rangeCount;
+
+    DrawGeometryBufferRanges(culled.geometry.buffer, firstVertices, vertexCounts, rangeCount);
+}
@@ -0,0 +1,417 @@
+#pragma once
+#include "raylib.h"
+#include "Physics.h"
+#include "Collision.h"
+#include "Projectiles.h"
+#include "Profiler.h"
+#include "LevelFile.h"
+#include "ObstacleEdit.h"
+#include "WorldStream.h"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+// xorshift64* random generator, a single POD word so it snapshots with a memcpy
+struct Rng
+{
+    uint64_t state = 0x9E3779B97F4A7C15ull;
+};
+
+uint32_t NextU32(Rng& rng)
+{
+    rng.state ^= rng.state >> 12;
+    rng.state ^= rng.state << 25;
+    rng.state ^= rng.state >> 27;
+    return (uint32_t)((rng.state * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+// Uniform float in [min, max)
+float NextFloat(Rng& rng, float min, float max)
+{
+    return min + (max - min) * (NextU32(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+const float playerRange = 1000.0f;
+const float playerRotationSpeed = 100.0f;
+const float bodyRestitution = 0.8f;
+const Vector2 gravity{ 0.0f, 400.0f };
+const int projectilesPerTick = 16;
+const float projectileSpeed = 1500.0f;
+const float projectileSpread = 5.0f * DEG2RAD;
+const float projectileLife = 2.0f;
+
+// Everything that evolves from tick to tick
+struct Simulation
+{
+    uint64_t tick = 0;
+    Vector2 playerPosition{ 0.0f, 0.0f };
+    float playerRotation = 0.0f;
+    Rng rng;
+    PhysicsWorld<SemiImplicitEuler> physics;
+    Rectangle bounds{ 0.0f, 0.0f, 1280.0f, 720.0f };    // bodies bounce off the edges
+    ProjectilePool projectiles;         // empty until InitProjectiles gives it a capacity
+
+    // Never changed once made: a change swaps in a new set, so snapshots and frames share it
+    std::shared_ptr<const std::vector<Rectangle>> obstacles = std::make_shared<const std::vector<Rectangle>>();
+    uint32_t obstaclesVersion = 0;      // a new NewObstaclesVersion whenever obstacles change, so copies can skip them
+
+    // Derived from obstacles, rebuilt by UpdateObstacleGrid rather than snapshotted
+    ObstacleGrid obstacleGrid;
+    uint32_t obstacleGridVersion = ~0u;
+
+    // The last few edits, so copies of older obstacles can catch up in place; not snapshotted
+    ObstacleEditLog obstacleEdits;
+
+    // If set, obstacles and their grid are the chunks of a world around the player, stitched
+    // again by UpdateObstacleGrid whenever the player reaches another chunk; not snapshotted
+    WorldStream* world = nullptr;
+    uint32_t stitchedObstaclesVersion = ~0u; // obstaclesVersion of the last stitch
+};
+
+const size_t obstacleEditLogSize = 8;
+
+struct PlayerInput
+{
+    Vector2 position{ 0.0f, 0.0f };     // the player follows the mouse
+    bool rotateCW = false;
+    bool rotateCCW = false;
+    bool fire = false;
+};
+
+struct LaserResult
+{
+    Vector2 start, end;
+    Vector2 poi;
+    bool hit;
+    int obstacle;       // index into obstacles, -1 if nothing was hit
+};
+
+// Replaces sim's obstacles with those in a binary level or a text obstacle file
+// A level's grid is taken as it is, so loading one never parses or builds anything
+bool LoadLevel(Simulation& sim, const char* path)
+{
+    bool hasGrid = false;
+    std::vector<Rectangle> obstacles;
+    if (!LoadObstacleFile(path, obstacles, sim.obstacleGrid, hasGrid)) return false;
+    sim.obstacles = std::make_shared<const std::vector<Rectangle>>(std::move(obstacles));
+    sim.obstaclesVersion = NewObstaclesVersion();
+    if (hasGrid) sim.obstacleGridVersion = sim.obstaclesVersion;
+    return true;
+}
+
+// Applies an edit, e.g. from reloading the obstacle file: sim's obstacles become result, the
+// whole set after the edit, and the grid is updated in place if it was built from the edit's base
+void ApplyObstacleEdit(Simulation& sim, const std::shared_ptr<const ObstacleEdit>& edit, const std::shared_ptr<const std::vector<Rectangle>>& result)
+{
+    PROFILE_ZONE("Apply obstacle edit");
+    if (sim.obstaclesVersion == edit->baseVersion && sim.obstacleGridVersion == sim.obstaclesVersion &&
+        ApplyObstacleEdit(sim.obstacleGrid, *edit))
+        sim.obstacleGridVersion = edit->version;
+    sim.obstacles = result;
+    sim.obstaclesVersion = edit->version;
+
+    if (sim.obstacleEdits.size() == obstacleEditLogSize)
+        sim.obstacleEdits.erase(sim.obstacleEdits.begin());
+    sim.obstacleEdits.push_back(edit);
+}
+
+void ApplyInput(Simulation& sim, const PlayerInput& input, float dt)
+{
+    sim.playerPosition = input.position;
+    if (input.rotateCW)
+        sim.playerRotation += playerRotationSpeed * dt;
+    if (input.rotateCCW)
+        sim.playerRotation -= playerRotationSpeed * dt;
+}
+
+// Restitches a streamed world's obstacles too, including after a rewind restored older ones
+void UpdateObstacleGrid(Simulation& sim)
+{
+    if (sim.world != nullptr && (UpdateWorldStream(*sim.world, sim.playerPosition) || sim.obstaclesVersion != sim.stitchedObstaclesVersion))
+    {
+        std::shared_ptr<std::vector<Rectangle>> obstacles = std::make_shared<std::vector<Rectangle>>();
+        StitchWorldWindow(*sim.world, *obstacles, sim.obstacleGrid);
+        sim.obstacles = obstacles;
+        sim.obstaclesVersion = sim.obstacleGridVersion = sim.stitchedObstaclesVersion = NewObstaclesVersion();
+    }
+    if (sim.obstacleGridVersion == sim.obstaclesVersion) return;
+    BuildObstacleGrid(sim.obstacleGrid, *sim.obstacles, 64.0f);
+    sim.obstacleGridVersion = sim.obstaclesVersion;
+}
+
+// Integrates bodies under gravity, then pushes any body that ended up inside an obstacle
+// or outside the bounds back out along the shallowest axis and reflects its velocity
+void StepBodies(Simulation& sim, float dt)
+{
+    Step(sim.physics, dt, [](const Vector2& pos, const Vector2& vel) { return gravity; });
+
+    const Rectangle& bounds = sim.bounds;
+    const std::vector<Rectangle>& obstacles = *sim.obstacles;
+    for (size_t i = 0; i < sim.physics.bodies.size(); i++)
+    {
+        Vector2& pos = sim.physics.positions[i];
+        Vector2& vel = sim.physics.bodies[i].vel;
+
+        QueryObstacles(sim.obstacleGrid, obstacles, Rectangle{ pos.x, pos.y, 0.0f, 0.0f }, [&](int index)
+            {
+                const Rectangle& obstacle = obstacles[index];
+                const float left = pos.x - obstacle.x;
+                const float right = obstacle.x + obstacle.width - pos.x;
+                const float top = pos.y - obstacle.y;
+                const float bottom = obstacle.y + obstacle.height - pos.y;
+                const float penetration = std::min(std::min(left, right), std::min(top, bottom));
+
+                if (penetration == left) { pos.x = obstacle.x; vel.x = -fabsf(vel.x) * bodyRestitution; }
+                else if (penetration == right) { pos.x = obstacle.x + obstacle.width; vel.x = fabsf(vel.x) * bodyRestitution; }
+                else if (penetration == top) { pos.y = obstacle.y; vel.y = -fabsf(vel.y) * bodyRestitution; }
+                else { pos.y = obstacle.y + obstacle.height; vel.y = fabsf(vel.y) * bodyRestitution; }
+            });
+
+        if (pos.x < bounds.x) { pos.x = bounds.x; vel.x = fabsf(vel.x) * bodyRestitution; }
+        if (pos.x > bounds.x + bounds.width) { pos.x = bounds.x + bounds.width; vel.x = -fabsf(vel.x) * bodyRestitution; }
+        if (pos.y < bounds.y) { pos.y = bounds.y; vel.y = fabsf(vel.y) * bodyRestitution; }
+        if (pos.y > bounds.y + bounds.height) { pos.y = bounds.y + bounds.height; vel.y = -fabsf(vel.y) * bodyRestitution; }
+    }
+}
+
+// Sprays projectiles along the player's facing direction
+void FireProjectiles(Simulation& sim)
+{
+    const float heading = sim.playerRotation * DEG2RAD;
+    for (int i = 0; i < projectilesPerTick; i++)
+    {
+        const Vector2 velocity = Direction(heading + NextFloat(sim.rng, -projectileSpread, projectileSpread)) * projectileSpeed;
+        if (!SpawnProjectile(sim.projectiles, sim.playerPosition, velocity, projectileLife)) break;
+    }
+}
+
+// Nearest obstacle hit along the player's facing direction
+// Requires an up-to-date obstacle grid
+LaserResult CastLaser(const Simulation& sim)
+{
+    LaserResult laser;
+    laser.start = sim.playerPosition;
+    laser.end = sim.playerPosition + Direction(sim.playerRotation * DEG2RAD) * playerRange;
+    laser.poi = laser.end;
+    laser.obstacle = Raycast(sim.obstacleGrid, *sim.obstacles, laser.start, laser.end, laser.poi);
+    laser.hit = laser.obstacle >= 0;
+    return laser;
+}
+
+void Tick(Simulation& sim, const PlayerInput& input, float dt)
+{
+    PROFILE_ZONE("Tick");
+    ApplyInput(sim, input, dt);
+    {
+        PROFILE_ZONE("Obstacle grid");
+        UpdateObstacleGrid(sim);
+    }
+    {
+        PROFILE_ZONE("Physics");
+        StepBodies(sim, dt);
+    }
+    {
+        PROFILE_ZONE("Projectiles");
+        if (input.fire)
+            FireProjectiles(sim);
+        StepProjectiles(sim.projectiles, sim.obstacleGrid, *sim.obstacles, dt);
+    }
+    sim.tick++;
+}
+
+//----------------------------------------------------------------------------------
+// Frames
+//----------------------------------------------------------------------------------
+// What drawing needs from one tick, copied out so it can be rendered on another thread while
+// the simulation moves on. Frames are reused, so copies stop allocating once they've grown.
+// Obstacles are shared with the simulation, and their grid is only updated when the version differs.
+
+struct SimulationFrame
+{
+    uint64_t tick = 0;
+    Vector2 playerPosition{ 0.0f, 0.0f };
+    float playerRotation = 0.0f;
+    LaserResult laser{};
+
+    int projectileCount = 0;
+    std::vector<float> px, py;
+    std::vector<float> vx, vy;
+
+    std::shared_ptr<const std::vector<Rectangle>> obstacles;
+    ObstacleGrid obstacleGrid;
+    uint32_t obstaclesVersion = ~0u;
+    ObstacleEditLog obstacleEdits;      // for keeping copies made from earlier frames up to date
+};
+
+// Requires an up-to-date obstacle grid
+void CaptureFrame(SimulationFrame& frame, const Simulation& sim, const LaserResult& laser)
+{
+    PROFILE_ZONE("Capture frame");
+    frame.tick = sim.tick;
+    frame.playerPosition = sim.playerPosition;
+    frame.playerRotation = sim.playerRotation;
+    frame.laser = laser;
+
+    const ProjectilePool& projectiles = sim.projectiles;
+    const std::vector<float>* from[] = { &projectiles.px, &projectiles.py, &projectiles.vx, &projectiles.vy };
+    std::vector<float>* to[] = { &frame.px, &frame.py, &frame.vx, &frame.vy };
+    for (int i = 0; i < 4; i++)
+    {
+        to[i]->resize(projectiles.capacity);
+        memcpy(to[i]->data(), from[i]->data(), projectiles.count * sizeof(float));
+    }
+    frame.projectileCount = projectiles.count;
+
+    // Replays recent edits on the grid where possible rather than copying all of it
+    if (frame.obstaclesVersion != sim.obstaclesVersion)
+    {
+        if (frame.obstacles == nullptr || !ReplayObstacleEdits(sim.obstacleEdits, frame.obstaclesVersion, sim.obstaclesVersion, frame.obstacleGrid))
+            frame.obstacleGrid = sim.obstacleGrid;
+        frame.obstacles = sim.obstacles;
+        frame.obstaclesVersion = sim.obstaclesVersion;
+        frame.obstacleEdits = sim.obstacleEdits;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Snapshots
+//----------------------------------------------------------------------------------
+// Each snapshot is one contiguous block: header, positions, rigidbodies, then the live
+// projectile arrays. Hit events only describe the last tick and aren't saved.
+// Obstacles rarely change and are never changed in place, so slots share the simulation's set.
+
+struct SnapshotHeader
+{
+    uint64_t tick;
+    Vector2 playerPosition;
+    float playerRotation;
+    Rng rng;
+    uint64_t bodyCount;
+    uint64_t bodiesStarted;
+    uint64_t projectileCount;
+};
+
+struct Snapshot
+{
+    std::vector<unsigned char> block;
+    std::shared_ptr<const std::vector<Rectangle>> obstacles;
+    uint32_t obstaclesVersion = 0;
+};
+
+struct SnapshotRing
+{
+    std::vector<Snapshot> slots;
+    size_t head = 0;        // slot the next save writes to
+    size_t count = 0;       // number of valid snapshots
+};
+
+void InitSnapshots(SnapshotRing& ring, size_t capacity)
+{
+    ring.slots.assign(capacity, Snapshot{});
+    ring.head = 0;
+    ring.count = 0;
+}
+
+size_t SnapshotSlot(const SnapshotRing& ring, size_t framesBack)
+{
+    return (ring.head + ring.slots.size() - 1 - framesBack) % ring.slots.size();
+}
+
+void SaveSnapshot(SnapshotRing& ring, const Simulation& sim)
+{
+    Snapshot& snapshot = ring.slots[ring.head];
+    const PhysicsWorld<SemiImplicitEuler>& physics = sim.physics;
+
+    SnapshotHeader header;
+    header.tick = sim.tick;
+    header.playerPosition = sim.playerPosition;
+    header.playerRotation = sim.playerRotation;
+    header.rng = sim.rng;
+    header.bodyCount = physics.bodies.size();
+    header.bodiesStarted = physics.started;
+    header.projectileCount = sim.projectiles.count;
+
+    const ProjectilePool& projectiles = sim.projectiles;
+    const std::vector<float>* projectileArrays[] = { &projectiles.px, &projectiles.py, &projectiles.vx, &projectiles.vy, &projectiles.life };
+    const size_t positionsSize = physics.positions.size() * sizeof(Vector2);
+    const size_t bodiesSize = physics.bodies.size() * sizeof(Rigidbody);
+    const size_t projectileArraySize = projectiles.count * sizeof(float);
+
+    // Slots keep their capacity and reserve room for a full projectile pool up front, so
+    // steady-state saves don't allocate even as the projectile count climbs
+    if (snapshot.block.empty())
+        snapshot.block.reserve(sizeof(SnapshotHeader) + positionsSize + bodiesSize + 5 * projectiles.capacity * sizeof(float));
+    snapshot.block.resize(sizeof(SnapshotHeader) + positionsSize + bodiesSize + 5 * projectileArraySize);
+    unsigned char* out = snapshot.block.data();
+    memcpy(out, &header, sizeof(SnapshotHeader));
+    memcpy(out + sizeof(SnapshotHeader), physics.positions.data(), positionsSize);
+    memcpy(out + sizeof(SnapshotHeader) + positionsSize, physics.bodies.data(), bodiesSize);
+    out += sizeof(SnapshotHeader) + positionsSize + bodiesSize;
+    for (const std::vector<float>* array : projectileArrays)
+    {
+        memcpy(out, array->data(), projectileArraySize);
+        out += projectileArraySize;
+    }
+
+    snapshot.obstacles = sim.obstacles;
+    snapshot.obstaclesVersion = sim.obstaclesVersion;
+
+    ring.head = (ring.head + 1) % ring.slots.size();
+    ring.count = std::min(ring.count + 1, ring.slots.size());
+}
+
+// Restores the snapshot saved framesBack saves ago (0 = most recent)
+// Newer snapshots are kept, so restoring can scrub back and forth through history
+bool RestoreSnapshot(const SnapshotRing& ring, Simulation& sim, size_t framesBack = 0)
+{
+    if (framesBack >= ring.count) return false;
+    const Snapshot& snapshot = ring.slots[SnapshotSlot(ring, framesBack)];
+    PhysicsWorld<SemiImplicitEuler>& physics = sim.physics;
+
+    SnapshotHeader header;
+    const unsigned char* in = snapshot.block.data();
+    memcpy(&header, in, sizeof(SnapshotHeader));
+    sim.tick = header.tick;
+    sim.playerPosition = header.playerPosition;
+    sim.playerRotation = header.playerRotation;
+    sim.rng = header.rng;
+
+    const size_t positionsSize = header.bodyCount * sizeof(Vector2);
+    physics.positions.resize(header.bodyCount);
+    physics.bodies.resize(header.bodyCount);
+    physics.started = header.bodiesStarted;
+    memcpy(physics.positions.data(), in + sizeof(SnapshotHeader), positionsSize);
+    memcpy(physics.bodies.data(), in + sizeof(SnapshotHeader) + positionsSize, header.bodyCount * sizeof(Rigidbody));
+
+    // The pool's capacity doesn't change between saves, so the arrays are already big enough
+    ProjectilePool& projectiles = sim.projectiles;
+    std::vector<float>* projectileArrays[] = { &projectiles.px, &projectiles.py, &projectiles.vx, &projectiles.vy, &projectiles.life };
+    const size_t projectileArraySize = header.projectileCount * sizeof(float);
+    in += sizeof(SnapshotHeader) + positionsSize + header.bodyCount * sizeof(Rigidbody);
+    for (std::vector<float>* array : projectileArrays)
+    {
+        memcpy(array->data(), in, projectileArraySize);
+        in += projectileArraySize;
+    }
+    projectiles.count = (int)header.projectileCount;
+    projectiles.hitCount = 0;
+
+    if (sim.obstaclesVersion != snapshot.obstaclesVersion)
+    {
+        sim.obstacles = snapshot.obstacles;
+        sim.obstaclesVersion = snapshot.obstaclesVersion;
+    }
+
+    return true;
+}
+
+// Drops the framesBack most recent snapshots, e.g. after a rollback restores an older
+// state, so the next save continues the timeline from there
+void DiscardSnapshots(SnapshotRing& ring, size_t framesBack)
+{
+    framesBack = std::min(framesBack, ring.count);
+    ring.head = (ring.head + ring.slots.size() - framesBack) % ring.slots.size();
+    ring.count -= framesBack;
+}
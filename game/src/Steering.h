@@ -0,0 +1,691 @@
+#pragma once
+#include "Collision.h"
+#include "Physics.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+
+// Batched steering behaviours for large flocks
+// Agents are stored structure-of-arrays and re-sorted by spatial hash bucket every tick,
+// so each bucket's neighbours are contiguous and can be processed 4 at a time with SSE
+// (RM_SIMD, see Math.h; without it the same loops run scalar). Flocking and obstacle
+// avoidance, which cost the most, are split over worker threads that the flock keeps between
+// ticks, so a pass costs a wake-up rather than a thread start.
+
+struct SteeringParams
+{
+    float maxSpeed = 200.0f;
+    float maxForce = 400.0f;
+    float neighbourRadius = 50.0f;      // alignment + cohesion range, also the hash cell size
+    float separationRadius = 20.0f;
+    float arriveRadius = 150.0f;        // agents slow down inside this distance of the target (0 = plain seek)
+    float fleeRadius = 200.0f;          // agents only react to threats closer than this
+    float avoidanceRadius = 40.0f;      // obstacles closer than this push agents away
+
+    float seekWeight = 1.0f;
+    float fleeWeight = 2.0f;
+    float separationWeight = 1.5f;
+    float alignmentWeight = 1.0f;
+    float cohesionWeight = 1.0f;
+    float avoidanceWeight = 3.0f;
+
+    // Flocking is recomputed each tick for one agent in flockingSlices, by id, and the others
+    // reuse their last force; neighbours barely move in a tick, and it's most of the cost
+    int flockingSlices = 2;
+    int threads = 0;                    // for flocking and avoidance, 0 = one per hardware thread
+};
+
+// What's near one hash bucket's agents, gathered by each worker thread before testing them
+struct NeighbourBuffer
+{
+    std::vector<float> px, py;          // the first count are agents, padded with far away ones to a multiple of 4
+    std::vector<float> vx, vy;
+    int count = 0;
+    std::vector<Rectangle> obstacles;
+};
+
+// Threads kept by a flock and woken for each parallel pass; started on first use
+// Worker t (from 1) runs work(t) of every pass that has more than t threads
+struct SteeringWorkers
+{
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wake;       // a new pass, or stopping
+    std::condition_variable done;       // the last worker finished the pass
+    void (*call)(void* work, int t) = nullptr;
+    void* work = nullptr;
+    uint64_t pass = 0;
+    int active = 0;                     // threads in the current pass, the caller's included
+    int remaining = 0;                  // workers still running it
+    bool stopping = false;
+
+    ~SteeringWorkers();
+};
+
+struct Flock
+{
+    // Agent state, reordered by BuildSpatialHash
+    std::vector<float> px, py;
+    std::vector<float> vx, vy;
+    std::vector<float> fx, fy;          // steering force accumulated during a tick
+    std::vector<float> flockX, flockY;  // last flocking force, see SteeringParams::flockingSlices
+    std::vector<uint32_t> id;           // stable agent id that follows the agent through reordering
+    uint32_t tick = 0;
+
+    // Spatial hash, rebuilt every tick with a counting sort
+    // Cells wrap around a 2^hashBits square table, so neighbouring cells are neighbouring buckets
+    float invCellSize = 0.0f;
+    int hashBits = 0;
+    uint32_t hashMask = 0;
+    std::vector<uint32_t> bucket;       // hash bucket of each agent
+    std::vector<int> bucketStart;       // bucket count + 1 offsets into the agent arrays
+    std::vector<int> order;
+    std::vector<float> scratch;
+    std::vector<uint32_t> scratchId;
+    std::vector<NeighbourBuffer> neighbours;    // one per thread
+    SteeringWorkers workers;
+};
+
+void AddAgent(Flock& flock, Vector2 position, Vector2 velocity)
+{
+    flock.id.push_back((uint32_t)flock.px.size());
+    flock.px.push_back(position.x);
+    flock.py.push_back(position.y);
+    flock.vx.push_back(velocity.x);
+    flock.vy.push_back(velocity.y);
+    flock.fx.push_back(0.0f);
+    flock.fy.push_back(0.0f);
+    flock.flockX.push_back(0.0f);
+    flock.flockY.push_back(0.0f);
+}
+
+int AgentCount(const Flock& flock)
+{
+    return (int)flock.px.size();
+}
+
+uint32_t HashCell(int x, int y, int bits)
+{
+    const uint32_t mask = (1u << bits) - 1;
+    return ((uint32_t)x & mask) | (((uint32_t)y & mask) << bits);
+}
+
+// Sorts agents by hash bucket of a cellSize grid
+void BuildSpatialHash(Flock& flock, float cellSize)
+{
+    const int count = AgentCount(flock);
+
+    flock.hashBits = 2;
+    while ((1u << (flock.hashBits * 2)) < (uint32_t)count) flock.hashBits++;
+    flock.hashMask = (1u << flock.hashBits) - 1;
+    const uint32_t buckets = 1u << (flock.hashBits * 2);
+    flock.invCellSize = 1.0f / cellSize;
+
+    flock.bucket.resize(count);
+    flock.bucketStart.assign(buckets + 1, 0);
+    for (int i = 0; i < count; i++)
+    {
+        uint32_t b = HashCell((int)floorf(flock.px[i] * flock.invCellSize),
+            (int)floorf(flock.py[i] * flock.invCellSize), flock.hashBits);
+        flock.bucket[i] = b;
+        flock.bucketStart[b]++;
+    }
+
+    // Exclusive prefix sum, scatter, then shift the consumed offsets back into place
+    int sum = 0;
+    for (uint32_t b = 0; b <= buckets; b++)
+    {
+        int n = flock.bucketStart[b];
+        flock.bucketStart[b] = sum;
+        sum += n;
+    }
+
+    flock.order.resize(count);
+    for (int i = 0; i < count; i++)
+        flock.order[flock.bucketStart[flock.bucket[i]]++] = i;
+
+    for (uint32_t b = buckets; b > 0; b--)
+        flock.bucketStart[b] = flock.bucketStart[b - 1];
+    flock.bucketStart[0] = 0;
+
+    // Permute agent state into bucket order
+    flock.scratch.resize(count);
+    std::vector<float>* arrays[] = { &flock.px, &flock.py, &flock.vx, &flock.vy, &flock.flockX, &flock.flockY };
+    for (std::vector<float>* array : arrays)
+    {
+        for (int i = 0; i < count; i++)
+            flock.scratch[i] = (*array)[flock.order[i]];
+        array->swap(flock.scratch);
+    }
+
+    flock.scratchId.resize(count);
+    for (int i = 0; i < count; i++)
+        flock.scratchId[i] = flock.id[flock.order[i]];
+    flock.id.swap(flock.scratchId);
+}
+
+int SteeringThreads(const SteeringParams& params)
+{
+    if (params.threads > 0) return params.threads;
+    return (int)std::max(1u, std::thread::hardware_concurrency());
+}
+
+void RunSteeringWorker(SteeringWorkers& workers, int t, uint64_t seen)
+{
+    std::unique_lock<std::mutex> lock(workers.mutex);
+    for (;;)
+    {
+        workers.wake.wait(lock, [&] { return workers.stopping || workers.pass != seen; });
+        if (workers.stopping) return;
+        seen = workers.pass;
+        if (t >= workers.active) continue;
+
+        lock.unlock();
+        workers.call(workers.work, t);
+        lock.lock();
+        if (--workers.remaining == 0) workers.done.notify_one();
+    }
+}
+
+// Joins the workers; the next pass starts them again
+void StopSteeringWorkers(SteeringWorkers& workers)
+{
+    {
+        std::lock_guard<std::mutex> lock(workers.mutex);
+        workers.stopping = true;
+    }
+    workers.wake.notify_all();
+    for (std::thread& thread : workers.threads)
+        thread.join();
+    workers.threads.clear();
+    workers.stopping = false;
+}
+
+SteeringWorkers::~SteeringWorkers()
+{
+    StopSteeringWorkers(*this);
+}
+
+template<typename Work>
+void CallSteeringWork(void* work, int t)
+{
+    (*(Work*)work)(t);
+}
+
+// Calls work(t) for t in [0, threads), one per thread; the caller's thread runs t = 0 and
+// the rest run on the flock's workers, started the first time a pass needs them
+template<typename Work>
+void RunSteeringWorkers(SteeringWorkers& workers, int threads, Work&& work)
+{
+    if (threads <= 1)
+    {
+        work(0);
+        return;
+    }
+
+    typedef typename std::remove_reference<Work>::type WorkType;
+    {
+        std::lock_guard<std::mutex> lock(workers.mutex);
+        while ((int)workers.threads.size() < threads - 1)
+            workers.threads.emplace_back(RunSteeringWorker, std::ref(workers), (int)workers.threads.size() + 1, workers.pass);
+        workers.call = CallSteeringWork<WorkType>;
+        workers.work = (void*)&work;
+        workers.active = threads;
+        workers.remaining = threads - 1;
+        workers.pass++;
+    }
+    workers.wake.notify_all();
+
+    work(0);
+    std::unique_lock<std::mutex> lock(workers.mutex);
+    workers.done.wait(lock, [&] { return workers.remaining == 0; });
+}
+
+#if RM_SIMD
+// Sum of the four lanes
+float HorizontalSum(__m128 v)
+{
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+}
+#endif
+
+// Adds weight * (desired - velocity), desired pointing at target at maxSpeed
+// Inside slowRadius the desired speed ramps down to zero (arrive); slowRadius <= 0 is plain seek
+void ArriveBatch(const float* px, const float* py, const float* vx, const float* vy,
+    float* fx, float* fy, int count, Vector2 target, float maxSpeed, float slowRadius, float weight)
+{
+    const bool arrive = slowRadius > 0.0f;
+    const float invSlow = arrive ? 1.0f / slowRadius : 0.0f;
+
+    int i = 0;
+#if RM_SIMD
+    const __m128 tx = _mm_set1_ps(target.x), ty = _mm_set1_ps(target.y);
+    const __m128 speed = _mm_set1_ps(maxSpeed), w = _mm_set1_ps(weight);
+    const __m128 one = _mm_set1_ps(1.0f), zero = _mm_setzero_ps(), inv = _mm_set1_ps(invSlow);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(tx, _mm_loadu_ps(px + i));
+        __m128 dy = _mm_sub_ps(ty, _mm_loadu_ps(py + i));
+        __m128 d = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+        __m128 ramp = arrive ? _mm_min_ps(one, _mm_mul_ps(d, inv)) : one;
+        __m128 scale = _mm_and_ps(_mm_cmpgt_ps(d, zero), _mm_div_ps(_mm_mul_ps(speed, ramp), d));
+        __m128 sx = _mm_sub_ps(_mm_mul_ps(dx, scale), _mm_loadu_ps(vx + i));
+        __m128 sy = _mm_sub_ps(_mm_mul_ps(dy, scale), _mm_loadu_ps(vy + i));
+        _mm_storeu_ps(fx + i, _mm_add_ps(_mm_loadu_ps(fx + i), _mm_mul_ps(sx, w)));
+        _mm_storeu_ps(fy + i, _mm_add_ps(_mm_loadu_ps(fy + i), _mm_mul_ps(sy, w)));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        float dx = target.x - px[i];
+        float dy = target.y - py[i];
+        float d = sqrtf(dx * dx + dy * dy);
+        float ramp = arrive ? fminf(1.0f, d * invSlow) : 1.0f;
+        float scale = d > 0.0f ? maxSpeed * ramp / d : 0.0f;
+        fx[i] += (dx * scale - vx[i]) * weight;
+        fy[i] += (dy * scale - vy[i]) * weight;
+    }
+}
+
+// Adds weight * (desired - velocity), desired pointing away from threat at maxSpeed
+// Only agents within panicRadius of the threat react
+void FleeBatch(const float* px, const float* py, const float* vx, const float* vy,
+    float* fx, float* fy, int count, Vector2 threat, float maxSpeed, float panicRadius, float weight)
+{
+    int i = 0;
+#if RM_SIMD
+    const __m128 tx = _mm_set1_ps(threat.x), ty = _mm_set1_ps(threat.y);
+    const __m128 speed = _mm_set1_ps(maxSpeed), w = _mm_set1_ps(weight);
+    const __m128 zero = _mm_setzero_ps(), r2 = _mm_set1_ps(panicRadius * panicRadius);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(px + i), tx);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(py + i), ty);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 mask = _mm_and_ps(_mm_cmplt_ps(d2, r2), _mm_cmpgt_ps(d2, zero));
+        __m128 scale = _mm_div_ps(speed, _mm_sqrt_ps(d2));
+        __m128 sx = _mm_and_ps(mask, _mm_sub_ps(_mm_mul_ps(dx, scale), _mm_loadu_ps(vx + i)));
+        __m128 sy = _mm_and_ps(mask, _mm_sub_ps(_mm_mul_ps(dy, scale), _mm_loadu_ps(vy + i)));
+        _mm_storeu_ps(fx + i, _mm_add_ps(_mm_loadu_ps(fx + i), _mm_mul_ps(sx, w)));
+        _mm_storeu_ps(fy + i, _mm_add_ps(_mm_loadu_ps(fy + i), _mm_mul_ps(sy, w)));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        float dx = px[i] - threat.x;
+        float dy = py[i] - threat.y;
+        float d2 = dx * dx + dy * dy;
+        if (d2 >= panicRadius * panicRadius || d2 <= 0.0f) continue;
+        float scale = maxSpeed / sqrtf(d2);
+        fx[i] += (dx * scale - vx[i]) * weight;
+        fy[i] += (dy * scale - vy[i]) * weight;
+    }
+}
+
+// Smallest rectangle holding bucket b's agents
+Rectangle BucketBounds(const Flock& flock, uint32_t b)
+{
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (int i = flock.bucketStart[b]; i < flock.bucketStart[b + 1]; i++)
+    {
+        minX = std::min(minX, flock.px[i]);
+        minY = std::min(minY, flock.py[i]);
+        maxX = std::max(maxX, flock.px[i]);
+        maxY = std::max(maxY, flock.py[i]);
+    }
+    return Rectangle{ minX, minY, maxX - minX, maxY - minY };
+}
+
+// Squared distance between two rectangles, 0 if they overlap
+float RectangleDistanceSqr(Rectangle a, Rectangle b)
+{
+    const float dx = std::max(0.0f, std::max(a.x - (b.x + b.width), b.x - (a.x + a.width)));
+    const float dy = std::max(0.0f, std::max(a.y - (b.y + b.height), b.y - (a.y + a.height)));
+    return dx * dx + dy * dy;
+}
+
+// First bucket of thread t's share of the agents, so each thread gets about as many
+uint32_t FirstWorkerBucket(const Flock& flock, int t, int threads)
+{
+    const uint32_t buckets = (uint32_t)flock.bucketStart.size() - 1;
+    if (t == threads) return buckets;
+    const int agent = (int)((int64_t)AgentCount(flock) * t / threads);
+    return (uint32_t)(std::lower_bound(flock.bucketStart.begin(), flock.bucketStart.end(), agent) - flock.bucketStart.begin());
+}
+
+// Gathers the agents of the 3x3 buckets around bucket b that are within radius of the box
+// bounding its agents. Pruning before the pairwise pass drops the corners of the neighbourhood
+// and agents of far away cells that share its buckets, and leaves a contiguous run to test.
+// Requires BuildSpatialHash with a cell size of at least radius.
+void GatherNeighbours(const Flock& flock, uint32_t b, float radius, NeighbourBuffer& out)
+{
+    // The three buckets of a row are one contiguous run unless the row wraps around the table
+    int runs[9][2];
+    int runCount = 0, total = 0;
+    const int bx = (int)(b & flock.hashMask);
+    const int by = (int)(b >> flock.hashBits);
+    for (int dy = -1; dy <= 1; dy++)
+    {
+        const uint32_t row = HashCell(0, by + dy, flock.hashBits);
+        const uint32_t x0 = (uint32_t)(bx - 1) & flock.hashMask;
+        const int dxCount = x0 + 2 <= flock.hashMask ? 1 : 3;
+        for (int dx = 0; dx < dxCount; dx++)
+        {
+            const uint32_t cell = dxCount == 1 ? row + x0 : HashCell(bx + dx - 1, by + dy, flock.hashBits);
+            runs[runCount][0] = flock.bucketStart[cell];
+            runs[runCount][1] = flock.bucketStart[cell + (dxCount == 1 ? 3 : 1)];
+            total += runs[runCount][1] - runs[runCount][0];
+            runCount++;
+        }
+    }
+
+    // Every candidate is written and only the ones in range are kept, so there's no branch to mispredict
+    if (out.px.size() < (size_t)total + 3)
+    {
+        out.px.resize(total + 3);
+        out.py.resize(total + 3);
+        out.vx.resize(total + 3);
+        out.vy.resize(total + 3);
+    }
+    const Rectangle bounds = BucketBounds(flock, b);
+    const float minX = bounds.x, maxX = bounds.x + bounds.width;
+    const float minY = bounds.y, maxY = bounds.y + bounds.height;
+    const float r2 = radius * radius;
+    float* ox = out.px.data();
+    float* oy = out.py.data();
+    float* ovx = out.vx.data();
+    float* ovy = out.vy.data();
+    int count = 0;
+    for (int r = 0; r < runCount; r++)
+    {
+        for (int j = runs[r][0]; j < runs[r][1]; j++)
+        {
+            const float x = flock.px[j], y = flock.py[j];
+            const float dx = std::max(0.0f, std::max(minX - x, x - maxX));
+            const float dy = std::max(0.0f, std::max(minY - y, y - maxY));
+            ox[count] = x;
+            oy[count] = y;
+            ovx[count] = flock.vx[j];
+            ovy[count] = flock.vy[j];
+            count += dx * dx + dy * dy < r2;
+        }
+    }
+
+    // Padding is too far away to be anyone's neighbour
+    out.count = count;
+    while (out.count % 4 != 0)
+    {
+        ox[out.count] = oy[out.count] = 1e30f;
+        ovx[out.count] = ovy[out.count] = 0.0f;
+        out.count++;
+    }
+}
+
+// Flocking for the agents of buckets [first, last)
+void FlockingBuckets(Flock& flock, const SteeringParams& params, uint32_t first, uint32_t last, NeighbourBuffer& neighbours)
+{
+    const float* px = flock.px.data();
+    const float* py = flock.py.data();
+    const float* vx = flock.vx.data();
+    const float* vy = flock.vy.data();
+
+    const float r2 = params.neighbourRadius * params.neighbourRadius;
+    const float sepR2 = params.separationRadius * params.separationRadius;
+#if RM_SIMD
+    const __m128 vr2 = _mm_set1_ps(r2), vsepR2 = _mm_set1_ps(sepR2);
+    const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+#endif
+
+    const uint32_t slices = (uint32_t)std::max(1, params.flockingSlices);
+    const uint32_t slice = flock.tick % slices;
+    for (uint32_t b = first; b < last; b++)
+    {
+        GatherNeighbours(flock, b, params.neighbourRadius, neighbours);
+        const int candidates = neighbours.count;
+        const float* ox = neighbours.px.data();
+        const float* oy = neighbours.py.data();
+        const float* ovx = neighbours.vx.data();
+        const float* ovy = neighbours.vy.data();
+
+        for (int i = flock.bucketStart[b]; i < flock.bucketStart[b + 1]; i++)
+        {
+            if (flock.id[i] % slices != slice)
+            {
+                flock.fx[i] += flock.flockX[i];
+                flock.fy[i] += flock.flockY[i];
+                continue;
+            }
+
+            float n, sepX, sepY, aliX, aliY, cohX, cohY;
+#if RM_SIMD
+            const __m128 x = _mm_set1_ps(px[i]), y = _mm_set1_ps(py[i]);
+            __m128 vn = zero, vsepX = zero, vsepY = zero, valiX = zero, valiY = zero, vcohX = zero, vcohY = zero;
+            for (int j = 0; j < candidates; j += 4)
+            {
+                __m128 jx = _mm_loadu_ps(ox + j), jy = _mm_loadu_ps(oy + j);
+                __m128 ddx = _mm_sub_ps(x, jx), ddy = _mm_sub_ps(y, jy);
+                __m128 d2 = _mm_add_ps(_mm_mul_ps(ddx, ddx), _mm_mul_ps(ddy, ddy));
+                __m128 inRange = _mm_and_ps(_mm_cmplt_ps(d2, vr2), _mm_cmpgt_ps(d2, zero));
+                __m128 inSeparation = _mm_and_ps(inRange, _mm_cmplt_ps(d2, vsepR2));
+                __m128 invD2 = _mm_rcp_ps(d2);     // 12-bit reciprocal is plenty for a repulsion weight
+
+                vn = _mm_add_ps(vn, _mm_and_ps(inRange, one));
+                valiX = _mm_add_ps(valiX, _mm_and_ps(inRange, _mm_loadu_ps(ovx + j)));
+                valiY = _mm_add_ps(valiY, _mm_and_ps(inRange, _mm_loadu_ps(ovy + j)));
+                vcohX = _mm_add_ps(vcohX, _mm_and_ps(inRange, jx));
+                vcohY = _mm_add_ps(vcohY, _mm_and_ps(inRange, jy));
+                vsepX = _mm_add_ps(vsepX, _mm_and_ps(inSeparation, _mm_mul_ps(ddx, invD2)));
+                vsepY = _mm_add_ps(vsepY, _mm_and_ps(inSeparation, _mm_mul_ps(ddy, invD2)));
+            }
+            n = HorizontalSum(vn);
+            sepX = HorizontalSum(vsepX);
+            sepY = HorizontalSum(vsepY);
+            aliX = HorizontalSum(valiX);
+            aliY = HorizontalSum(valiY);
+            cohX = HorizontalSum(vcohX);
+            cohY = HorizontalSum(vcohY);
+#else
+            n = sepX = sepY = aliX = aliY = cohX = cohY = 0.0f;
+            for (int j = 0; j < candidates; j++)
+            {
+                float ddx = px[i] - ox[j];
+                float ddy = py[i] - oy[j];
+                float d2 = ddx * ddx + ddy * ddy;
+                if (d2 >= r2 || d2 <= 0.0f) continue;
+
+                n += 1.0f;
+                aliX += ovx[j];
+                aliY += ovy[j];
+                cohX += ox[j];
+                cohY += oy[j];
+                if (d2 < sepR2)
+                {
+                    sepX += ddx / d2;
+                    sepY += ddy / d2;
+                }
+            }
+#endif
+            flock.flockX[i] = flock.flockY[i] = 0.0f;
+            if (n == 0.0f) continue;
+
+            const Vector2 velocity{ vx[i], vy[i] };
+            const Vector2 separation{ sepX, sepY };
+            const Vector2 alignment{ aliX, aliY };
+            const Vector2 center = Vector2{ cohX, cohY } / n;
+
+            Vector2 force = Vector2Zero();
+            if (LengthSqr(separation) > 0.0f)
+                force = force + (Normalize(separation) * params.maxSpeed - velocity) * params.separationWeight;
+            force = force + (Normalize(alignment) * params.maxSpeed - velocity) * params.alignmentWeight;
+            force = force + Seek(center, { px[i], py[i] }, velocity, params.maxSpeed) * params.cohesionWeight;
+
+            flock.flockX[i] = force.x;
+            flock.flockY[i] = force.y;
+            flock.fx[i] += force.x;
+            flock.fy[i] += force.y;
+        }
+    }
+}
+
+// Separation, alignment and cohesion from neighbours found through the spatial hash
+// Requires BuildSpatialHash with a cell size of at least params.neighbourRadius
+void FlockingBatch(Flock& flock, const SteeringParams& params, int threads)
+{
+    if (flock.neighbours.size() < (size_t)threads) flock.neighbours.resize(threads);
+    RunSteeringWorkers(flock.workers, threads, [&](int t)
+        {
+            FlockingBuckets(flock, params, FirstWorkerBucket(flock, t, threads), FirstWorkerBucket(flock, t + 1, threads), flock.neighbours[t]);
+        });
+}
+
+// Obstacle avoidance for the agents of buckets [first, last)
+// A bucket's agents are close together, so the grid is searched once per bucket for everything
+// in range of any of them, and each agent only tests that short list.
+void AvoidObstaclesBuckets(Flock& flock, const SteeringParams& params, const ObstacleGrid& grid,
+    const std::vector<Rectangle>& obstacles, uint32_t first, uint32_t last, NeighbourBuffer& nearby)
+{
+    const float radius = params.avoidanceRadius;
+    const float strength = params.maxForce * params.avoidanceWeight;
+
+    for (uint32_t b = first; b < last; b++)
+    {
+        if (flock.bucketStart[b] == flock.bucketStart[b + 1]) continue;
+        const Rectangle bounds = BucketBounds(flock, b);
+        const Rectangle area{ bounds.x - radius, bounds.y - radius, bounds.width + radius * 2.0f, bounds.height + radius * 2.0f };
+        nearby.obstacles.clear();
+        QueryObstacles(grid, obstacles, area, [&](int index)
+            {
+                if (RectangleDistanceSqr(bounds, obstacles[index]) < radius * radius)
+                    nearby.obstacles.push_back(obstacles[index]);
+            });
+        if (nearby.obstacles.empty()) continue;
+
+        for (int i = flock.bucketStart[b]; i < flock.bucketStart[b + 1]; i++)
+        {
+            const Vector2 position{ flock.px[i], flock.py[i] };
+            Vector2 push = Vector2Zero();
+            for (const Rectangle& obstacle : nearby.obstacles)
+            {
+                const Vector2 nearest{
+                    Clamp(position.x, obstacle.x, obstacle.x + obstacle.width),
+                    Clamp(position.y, obstacle.y, obstacle.y + obstacle.height) };
+                const Vector2 away = position - nearest;
+                const float d2 = LengthSqr(away);
+                if (d2 >= radius * radius) continue;
+
+                if (d2 > 0.0f)
+                {
+                    const float d = sqrtf(d2);
+                    push = push + away * ((1.0f - d / radius) / d);
+                }
+                else
+                {
+                    // Inside the obstacle, head out through the nearest side
+                    const Vector2 center{ obstacle.x + obstacle.width * 0.5f, obstacle.y + obstacle.height * 0.5f };
+                    push = push + Normalize(position - center);
+                }
+            }
+
+            flock.fx[i] += push.x * strength;
+            flock.fy[i] += push.y * strength;
+        }
+    }
+}
+
+// Pushes agents out of obstacles closer than params.avoidanceRadius
+// Requires the spatial hash built this tick
+void AvoidObstaclesBatch(Flock& flock, const SteeringParams& params,
+    const ObstacleGrid& grid, const std::vector<Rectangle>& obstacles, int threads)
+{
+    if (flock.neighbours.size() < (size_t)threads) flock.neighbours.resize(threads);
+    RunSteeringWorkers(flock.workers, threads, [&](int t)
+        {
+            AvoidObstaclesBuckets(flock, params, grid, obstacles, FirstWorkerBucket(flock, t, threads),
+                FirstWorkerBucket(flock, t + 1, threads), flock.neighbours[t]);
+        });
+}
+
+// Truncates the accumulated force to maxForce, integrates with semi-implicit Euler
+// clamping speed to maxSpeed, then clears the force for the next tick
+void IntegrateAgents(float* px, float* py, float* vx, float* vy, float* fx, float* fy,
+    int count, float maxForce, float maxSpeed, float dt)
+{
+    int i = 0;
+#if RM_SIMD
+    const __m128 one = _mm_set1_ps(1.0f), zero = _mm_setzero_ps();
+    const __m128 mf = _mm_set1_ps(maxForce), ms = _mm_set1_ps(maxSpeed), vdt = _mm_set1_ps(dt);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 ax = _mm_loadu_ps(fx + i), ay = _mm_loadu_ps(fy + i);
+        __m128 f = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)));
+        __m128 fs = _mm_min_ps(one, _mm_div_ps(mf, f));
+        __m128 nvx = _mm_add_ps(_mm_loadu_ps(vx + i), _mm_mul_ps(_mm_mul_ps(ax, fs), vdt));
+        __m128 nvy = _mm_add_ps(_mm_loadu_ps(vy + i), _mm_mul_ps(_mm_mul_ps(ay, fs), vdt));
+        __m128 s = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(nvx, nvx), _mm_mul_ps(nvy, nvy)));
+        __m128 ss = _mm_min_ps(one, _mm_div_ps(ms, s));
+        nvx = _mm_mul_ps(nvx, ss);
+        nvy = _mm_mul_ps(nvy, ss);
+        _mm_storeu_ps(vx + i, nvx);
+        _mm_storeu_ps(vy + i, nvy);
+        _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(nvx, vdt)));
+        _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(nvy, vdt)));
+        _mm_storeu_ps(fx + i, zero);
+        _mm_storeu_ps(fy + i, zero);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        float f = sqrtf(fx[i] * fx[i] + fy[i] * fy[i]);
+        float fs = f > maxForce ? maxForce / f : 1.0f;
+        vx[i] += fx[i] * fs * dt;
+        vy[i] += fy[i] * fs * dt;
+        float s = sqrtf(vx[i] * vx[i] + vy[i] * vy[i]);
+        float ss = s > maxSpeed ? maxSpeed / s : 1.0f;
+        vx[i] *= ss;
+        vy[i] *= ss;
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        fx[i] = fy[i] = 0.0f;
+    }
+}
+
+// Runs every behaviour for one tick: agents arrive at target, flee from threat,
+// flock with their neighbours and steer clear of obstacles
+void UpdateFlock(Flock& flock, const SteeringParams& params, Vector2 target, Vector2 threat,
+    const ObstacleGrid& grid, const std::vector<Rectangle>& obstacles, float dt)
+{
+    const int count = AgentCount(flock);
+    if (count == 0) return;
+
+    BuildSpatialHash(flock, params.neighbourRadius);
+    const int threads = std::min(SteeringThreads(params), std::max(1, count / 4096));
+
+    float* px = flock.px.data();
+    float* py = flock.py.data();
+    float* vx = flock.vx.data();
+    float* vy = flock.vy.data();
+    float* fx = flock.fx.data();
+    float* fy = flock.fy.data();
+
+    if (params.seekWeight > 0.0f)
+        ArriveBatch(px, py, vx, vy, fx, fy, count, target, params.maxSpeed, params.arriveRadius, params.seekWeight);
+    if (params.fleeWeight > 0.0f)
+        FleeBatch(px, py, vx, vy, fx, fy, count, threat, params.maxSpeed, params.fleeRadius, params.fleeWeight);
+
+    FlockingBatch(flock, params, threads);
+    if (params.avoidanceWeight > 0.0f)
+        AvoidObstaclesBatch(flock, params, grid, obstacles, threads);
+
+    IntegrateAgents(px, py, vx, vy, fx, fy, count, params.maxForce, params.maxSpeed, dt);
+    flock.tick++;
+}
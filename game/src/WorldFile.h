@@ -0,0 +1,250 @@
+#pragma once
+#include "raylib.h"
+#include "Collision.h"
+#include "LevelFile.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Binary world files, for maps too large to hold in memory at once
+// The world is cut into square chunks, each stored as a level image (see LevelFile.h) holding
+// the obstacles whose top-left corner lies in the chunk, plus a grid of them. A table with an
+// entry per chunk says where each one is, so any chunk can be read on its own (see
+// WorldStream.h). Every chunk's grid lies on one lattice of cells anchored at the world origin,
+// so neighbouring chunks' grids can be stitched together without placing any obstacle again.
+// Written by levelconvert --world.
+
+const uint32_t worldMagic = 0x444C5753;     // "SWLD"
+const uint32_t worldVersion = 1;
+
+struct WorldHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    Vector2 origin;                     // top-left corner of the first chunk, a lattice point
+    float chunkSize;                    // a whole number of cells
+    float cellSize;
+    int32_t chunksX;
+    int32_t chunksY;
+    Rectangle bounds;                   // smallest rectangle containing every obstacle
+    uint64_t obstacleCount;
+    uint64_t chunkTable;                // chunksX * chunksY WorldChunkEntry, row by row
+    uint64_t fileSize;
+};
+
+static_assert(sizeof(WorldHeader) == 72, "WorldHeader layout changed, bump worldVersion");
+
+struct WorldChunkEntry
+{
+    uint64_t offset;                    // of the chunk's level image, 0 if the chunk is empty
+    uint64_t size;
+};
+
+// An open world file; only the header is kept, chunk table entries are read with their chunks
+// so memory doesn't grow with the world
+struct World
+{
+    FILE* file = nullptr;
+    std::string path;
+    WorldHeader header = {};
+    std::mutex mutex;                   // chunks are read from more than one thread
+};
+
+void CloseWorld(World& world)
+{
+    if (world.file != nullptr) fclose(world.file);
+    world.file = nullptr;
+    world.path.clear();
+    world.header = WorldHeader{};
+}
+
+bool OpenWorld(World& world, const char* path)
+{
+    CloseWorld(world);
+    world.file = fopen(path, "rb");
+    if (world.file == nullptr)
+    {
+        printf("failed to open %s\n", path);
+        return false;
+    }
+    world.path = path;
+
+    WorldHeader& header = world.header;
+    const bool read = fread(&header, sizeof(WorldHeader), 1, world.file) == 1;
+    FileSeek(world.file, 0);
+    fseek(world.file, 0, SEEK_END);
+    const uint64_t size = (uint64_t)FileTell(world.file);
+
+    const char* error = nullptr;
+    if (!read || header.magic != worldMagic)
+        error = "not a world file";
+    else if (header.fileSize != size)
+        error = "truncated";
+    else if (header.version != worldVersion)
+        error = "unsupported world version";
+    else if (header.chunksX <= 0 || header.chunksY <= 0 || !(header.chunkSize > 0.0f) || !(header.cellSize > 0.0f) ||
+        header.chunkTable < sizeof(WorldHeader) || header.chunkTable > size ||
+        (uint64_t)header.chunksX * header.chunksY * sizeof(WorldChunkEntry) > size - header.chunkTable)
+        error = "chunk table out of range";
+    if (error != nullptr)
+    {
+        printf("%s: %s\n", path, error);
+        CloseWorld(world);
+        return false;
+    }
+    return true;
+}
+
+// Index of the chunk at x, y, or -1 if that's outside the world
+int WorldChunkIndex(const WorldHeader& header, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= header.chunksX || y >= header.chunksY) return -1;
+    return y * header.chunksX + x;
+}
+
+// Reads a chunk into data, which only grows, and points level's views at it
+// An empty chunk leaves level with no obstacles and no grid. Safe to call from several threads.
+bool ReadWorldChunk(World& world, int chunk, std::vector<char>& data, Level& level)
+{
+    level = Level{};
+    bool read = false;
+    WorldChunkEntry entry = {};
+    {
+        std::lock_guard<std::mutex> lock(world.mutex);
+        read = FileSeek(world.file, (int64_t)(world.header.chunkTable + chunk * sizeof(WorldChunkEntry))) &&
+            fread(&entry, sizeof(WorldChunkEntry), 1, world.file) == 1;
+        if (read && entry.offset == 0) return true;
+        read = read && entry.offset <= world.header.fileSize && entry.size <= world.header.fileSize - entry.offset;
+        if (read)
+        {
+            data.resize((size_t)entry.size);
+            read = FileSeek(world.file, (int64_t)entry.offset) && fread(data.data(), 1, data.size(), world.file) == data.size();
+        }
+    }
+
+    if (!read)
+    {
+        printf("%s: failed to read chunk %d\n", world.path.c_str(), chunk);
+        return false;
+    }
+    return ViewLevel(level, data.data(), entry.size, world.path.c_str());
+}
+
+//----------------------------------------------------------------------------------
+// Writing
+//----------------------------------------------------------------------------------
+
+// Writes obstacles as a world of chunkSize chunks whose grids have cellSize cells
+// chunkSize is rounded up to a whole number of cells
+bool SaveWorld(const char* path, const std::vector<Rectangle>& obstacles, float chunkSize, float cellSize)
+{
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr)
+    {
+        printf("failed to create %s\n", path);
+        return false;
+    }
+
+    WorldHeader header = {};
+    header.magic = worldMagic;
+    header.version = worldVersion;
+    header.cellSize = cellSize;
+    header.chunkSize = ceilf(chunkSize / cellSize) * cellSize;
+    header.obstacleCount = obstacles.size();
+
+    // Chunks are found by top-left corner, so only the corners decide how many there are
+    Vector2 cornerMin{ 0.0f, 0.0f };
+    Vector2 cornerMax{ 0.0f, 0.0f };
+    if (!obstacles.empty())
+    {
+        cornerMin = cornerMax = Vector2{ obstacles[0].x, obstacles[0].y };
+        Vector2 max{ obstacles[0].x + obstacles[0].width, obstacles[0].y + obstacles[0].height };
+        for (const Rectangle& obstacle : obstacles)
+        {
+            cornerMin.x = std::min(cornerMin.x, obstacle.x);
+            cornerMin.y = std::min(cornerMin.y, obstacle.y);
+            cornerMax.x = std::max(cornerMax.x, obstacle.x);
+            cornerMax.y = std::max(cornerMax.y, obstacle.y);
+            max.x = std::max(max.x, obstacle.x + obstacle.width);
+            max.y = std::max(max.y, obstacle.y + obstacle.height);
+        }
+        header.bounds = Rectangle{ cornerMin.x, cornerMin.y, max.x - cornerMin.x, max.y - cornerMin.y };
+    }
+    header.origin = Vector2{ floorf(cornerMin.x / cellSize) * cellSize, floorf(cornerMin.y / cellSize) * cellSize };
+    header.chunksX = (int)((cornerMax.x - header.origin.x) / header.chunkSize) + 1;
+    header.chunksY = (int)((cornerMax.y - header.origin.y) / header.chunkSize) + 1;
+
+    // Counting sort of obstacle indices by chunk, keeping file order within each
+    const int chunks = header.chunksX * header.chunksY;
+    std::vector<int> chunkOf(obstacles.size());
+    std::vector<int> chunkStart(chunks + 1, 0);
+    for (size_t i = 0; i < obstacles.size(); i++)
+    {
+        const int x = std::min(header.chunksX - 1, (int)((obstacles[i].x - header.origin.x) / header.chunkSize));
+        const int y = std::min(header.chunksY - 1, (int)((obstacles[i].y - header.origin.y) / header.chunkSize));
+        chunkOf[i] = y * header.chunksX + x;
+        chunkStart[chunkOf[i] + 1]++;
+    }
+    for (int chunk = 0; chunk < chunks; chunk++)
+        chunkStart[chunk + 1] += chunkStart[chunk];
+    std::vector<int> order(obstacles.size());
+    std::vector<int> cursor(chunkStart.begin(), chunkStart.end() - 1);
+    for (size_t i = 0; i < obstacles.size(); i++)
+        order[cursor[chunkOf[i]]++] = (int)i;
+
+    // Header and table first as placeholders, rewritten once the offsets are known
+    std::vector<WorldChunkEntry> table(chunks, WorldChunkEntry{ 0, 0 });
+    fwrite(&header, sizeof(WorldHeader), 1, file);
+    uint64_t offset = sizeof(WorldHeader);
+    header.chunkTable = WriteLevelArray(file, offset, table.data(), table.size() * sizeof(WorldChunkEntry));
+
+    // Obstacles are placed in cells with some margin, so a stitched grid, whose origin is a
+    // different lattice point, can't round one of their edges into a cell the chunk didn't list
+    const float margin = cellSize / 16.0f;
+    std::vector<Rectangle> chunkObstacles;
+    ObstacleGrid grid;
+    for (int chunk = 0; chunk < chunks; chunk++)
+    {
+        if (chunkStart[chunk] == chunkStart[chunk + 1]) continue;
+        chunkObstacles.clear();
+        Vector2 min{ INFINITY, INFINITY };
+        Vector2 max{ -INFINITY, -INFINITY };
+        for (int i = chunkStart[chunk]; i < chunkStart[chunk + 1]; i++)
+        {
+            const Rectangle& obstacle = obstacles[order[i]];
+            chunkObstacles.push_back(obstacle);
+            min.x = std::min(min.x, obstacle.x - margin);
+            min.y = std::min(min.y, obstacle.y - margin);
+            max.x = std::max(max.x, obstacle.x + obstacle.width + margin);
+            max.y = std::max(max.y, obstacle.y + obstacle.height + margin);
+        }
+
+        // The chunk's grid covers its obstacles, overhang included, in whole lattice cells
+        const float cellX = floorf((min.x - header.origin.x) / cellSize);
+        const float cellY = floorf((min.y - header.origin.y) / cellSize);
+        grid.origin = Vector2{ header.origin.x + cellX * cellSize, header.origin.y + cellY * cellSize };
+        grid.cellSize = cellSize;
+        grid.invCellSize = 1.0f / cellSize;
+        grid.width = (int)((max.x - grid.origin.x) * grid.invCellSize) + 1;
+        grid.height = (int)((max.y - grid.origin.y) * grid.invCellSize) + 1;
+        FillObstacleGrid(grid, chunkObstacles, margin);
+
+        PadLevelFile(file, offset);
+        table[chunk].offset = offset;
+        table[chunk].size = WriteLevel(file, chunkObstacles, &grid);
+        offset += table[chunk].size;
+    }
+    header.fileSize = offset;
+
+    FileSeek(file, (int64_t)header.chunkTable);
+    fwrite(table.data(), sizeof(WorldChunkEntry), table.size(), file);
+    FileSeek(file, 0);
+    fwrite(&header, sizeof(WorldHeader), 1, file);
+    const bool written = !ferror(file);
+    fclose(file);
+    if (!written) printf("failed to write %s\n", path);
+    return written;
+}
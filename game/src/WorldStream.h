@@ -0,0 +1,322 @@
+#pragma once
+#include "raylib.h"
+#include "Collision.h"
+#include "Concurrency.h"
+#include "WorldFile.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Keeps the chunks of a world file (see WorldFile.h) around a moving point in memory
+// The chunks within activeRadius of the point's chunk are the active window. They're always
+// loaded, if need be by waiting, so what a simulation sees depends only on the point and never
+// on how fast the disk is. Chunks out to prefetchRadius are read on a background thread ahead
+// of time, so moving on rarely has to wait. Chunks live in a fixed set of slots and the least
+// recently used one is reused for the next chunk, so memory stays the same however large the
+// world is. Everything but the loader thread runs on the thread that owns the stream.
+
+struct WorldSlot
+{
+    int chunk = -1;                     // -1 if unused
+    bool loading = false;               // data and level belong to the loader thread until it's done
+    uint64_t lastUsed = 0;              // window update the chunk was last inside the prefetch radius
+    std::vector<char> data;             // the chunk's level image
+    Level level;                        // views into data
+};
+
+struct WorldStream
+{
+    World world;
+    int activeRadius = 1;
+    int prefetchRadius = 2;
+    std::vector<WorldSlot> slots;
+    std::vector<int> window;            // slots of the active window's chunks, row by row
+
+    // Slot indices to load and loaded, owner -> loader and back
+    SpscQueue<int> requests;
+    SpscQueue<int> completions;
+    std::thread loader;
+    std::atomic<bool> running{ false };
+
+    int centerX = 0;                    // chunk the window is around
+    int centerY = 0;
+    bool centered = false;
+    uint64_t updates = 0;
+
+    // Since the stream started
+    int loads = 0;                      // chunks read ahead in the background
+    int stalls = 0;                     // active chunks that weren't ready in time
+    int evictions = 0;
+};
+
+void RunWorldLoader(WorldStream& stream)
+{
+    while (stream.running.load(std::memory_order_relaxed))
+    {
+        int index;
+        if (!Pop(stream.requests, index))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        // A chunk that fails to read is reported and treated as empty
+        WorldSlot& slot = stream.slots[index];
+        ReadWorldChunk(stream.world, slot.chunk, slot.data, slot.level);
+        while (!Push(stream.completions, index))
+            std::this_thread::yield();
+    }
+}
+
+// Opens path and starts the loader thread; nothing is loaded until the first UpdateWorldStream
+bool StartWorldStream(WorldStream& stream, const char* path, int activeRadius, int prefetchRadius)
+{
+    if (!OpenWorld(stream.world, path)) return false;
+    stream.activeRadius = activeRadius;
+    stream.prefetchRadius = std::max(activeRadius, prefetchRadius);
+
+    // Enough for the prefetch area plus a spare row and column, so going back and forth over
+    // a chunk border doesn't read the same chunks again
+    const int side = stream.prefetchRadius * 2 + 1;
+    stream.slots.assign((side + 1) * (side + 1), WorldSlot{});
+    stream.window.reserve((activeRadius * 2 + 1) * (activeRadius * 2 + 1));
+    InitQueue(stream.requests, stream.slots.size());
+    InitQueue(stream.completions, stream.slots.size());
+    stream.centered = false;
+
+    stream.running.store(true);
+    stream.loader = std::thread([&stream]() { RunWorldLoader(stream); });
+    return true;
+}
+
+// Waits for reads in progress, then frees every chunk
+void StopWorldStream(WorldStream& stream)
+{
+    stream.running.store(false);
+    if (stream.loader.joinable()) stream.loader.join();
+    CloseWorld(stream.world);
+    stream.slots.clear();
+    stream.window.clear();
+}
+
+// Takes back slots the loader has finished with
+void CollectWorldLoads(WorldStream& stream)
+{
+    int index;
+    while (Pop(stream.completions, index))
+    {
+        stream.slots[index].loading = false;
+        stream.loads++;
+    }
+}
+
+bool InWorldWindow(const WorldStream& stream, int chunk, int radius)
+{
+    const int x = chunk % stream.world.header.chunksX;
+    const int y = chunk / stream.world.header.chunksX;
+    return abs(x - stream.centerX) <= radius && abs(y - stream.centerY) <= radius;
+}
+
+int FindWorldSlot(const WorldStream& stream, int chunk)
+{
+    for (size_t i = 0; i < stream.slots.size(); i++)
+        if (stream.slots[i].chunk == chunk) return (int)i;
+    return -1;
+}
+
+// A slot for chunk: an unused one, otherwise the least recently used one outside the prefetch
+// area. Returns -1 if there is none, which only happens with too few slots.
+int ClaimWorldSlot(WorldStream& stream, int chunk)
+{
+    int best = -1;
+    for (size_t i = 0; i < stream.slots.size(); i++)
+    {
+        const WorldSlot& slot = stream.slots[i];
+        if (slot.chunk < 0)
+        {
+            best = (int)i;
+            break;
+        }
+        if (slot.loading || InWorldWindow(stream, slot.chunk, stream.prefetchRadius)) continue;
+        if (best < 0 || slot.lastUsed < stream.slots[best].lastUsed) best = (int)i;
+    }
+    if (best < 0) return -1;
+
+    WorldSlot& slot = stream.slots[best];
+    if (slot.chunk >= 0) stream.evictions++;
+    slot.chunk = chunk;
+    slot.level = Level{};
+    slot.lastUsed = stream.updates;
+    return best;
+}
+
+void GetWorldChunk(const WorldStream& stream, Vector2 position, int& x, int& y)
+{
+    const WorldHeader& header = stream.world.header;
+    x = (int)floorf((position.x - header.origin.x) / header.chunkSize);
+    y = (int)floorf((position.y - header.origin.y) / header.chunkSize);
+}
+
+// True if UpdateWorldStream at position would move the window
+bool WorldWindowMoves(const WorldStream& stream, Vector2 position)
+{
+    int x, y;
+    GetWorldChunk(stream, position, x, y);
+    return !stream.centered || x != stream.centerX || y != stream.centerY;
+}
+
+// Moves the window to the chunk holding position and makes sure all of it is loaded
+// Call every tick, as it also finishes background loads; returns true if the window moved,
+// after which the active chunks should be stitched again
+bool UpdateWorldStream(WorldStream& stream, Vector2 position)
+{
+    CollectWorldLoads(stream);
+    if (!WorldWindowMoves(stream, position)) return false;
+
+    const WorldHeader& header = stream.world.header;
+    int centerX, centerY;
+    GetWorldChunk(stream, position, centerX, centerY);
+    stream.centerX = centerX;
+    stream.centerY = centerY;
+    stream.centered = true;
+    stream.updates++;
+
+    // Active chunks first: read here if missing, or wait for the loader if it has them
+    stream.window.clear();
+    for (int y = centerY - stream.activeRadius; y <= centerY + stream.activeRadius; y++)
+    {
+        for (int x = centerX - stream.activeRadius; x <= centerX + stream.activeRadius; x++)
+        {
+            const int chunk = WorldChunkIndex(header, x, y);
+            if (chunk < 0) continue;
+
+            int index = FindWorldSlot(stream, chunk);
+            if (index < 0)
+            {
+                index = ClaimWorldSlot(stream, chunk);
+                if (index < 0) continue;
+                ReadWorldChunk(stream.world, chunk, stream.slots[index].data, stream.slots[index].level);
+                stream.stalls++;
+            }
+            else if (stream.slots[index].loading)
+            {
+                while (stream.slots[index].loading)
+                {
+                    std::this_thread::yield();
+                    CollectWorldLoads(stream);
+                }
+                stream.stalls++;
+            }
+            stream.slots[index].lastUsed = stream.updates;
+            stream.window.push_back(index);
+        }
+    }
+
+    // Then the ring around them, in the background
+    for (int y = centerY - stream.prefetchRadius; y <= centerY + stream.prefetchRadius; y++)
+    {
+        for (int x = centerX - stream.prefetchRadius; x <= centerX + stream.prefetchRadius; x++)
+        {
+            const int chunk = WorldChunkIndex(header, x, y);
+            if (chunk < 0) continue;
+
+            int index = FindWorldSlot(stream, chunk);
+            if (index < 0)
+            {
+                index = ClaimWorldSlot(stream, chunk);
+                if (index < 0) continue;
+                stream.slots[index].loading = true;
+                Push(stream.requests, index);
+            }
+            stream.slots[index].lastUsed = stream.updates;
+        }
+    }
+    return true;
+}
+
+// Replaces obstacles with the active window's, chunk by chunk in row order, and grid with the
+// chunks' grids stitched into one over the same lattice
+// Nothing is placed in cells again: each of the stitched grid's cells takes the items of the
+// chunk cells at the same lattice position, renumbered to where the chunk's obstacles now start.
+// Only obstacles whose chunk is active are included, so near the edge of the window an obstacle
+// overhanging from an inactive chunk is missing; the window is kept well beyond what queries reach.
+void StitchWorldWindow(const WorldStream& stream, std::vector<Rectangle>& obstacles, ObstacleGrid& grid)
+{
+    const WorldHeader& header = stream.world.header;
+    obstacles.clear();
+    grid.width = grid.height = 0;
+
+    // Lattice cells covered by the chunks' grids
+    int xMin = INT32_MAX, yMin = INT32_MAX, xMax = INT32_MIN, yMax = INT32_MIN;
+    for (int index : stream.window)
+    {
+        const ObstacleGridView& chunkGrid = stream.slots[index].level.grid;
+        if (chunkGrid.width == 0) continue;
+        const int x = (int)lroundf((chunkGrid.origin.x - header.origin.x) / header.cellSize);
+        const int y = (int)lroundf((chunkGrid.origin.y - header.origin.y) / header.cellSize);
+        xMin = std::min(xMin, x);
+        yMin = std::min(yMin, y);
+        xMax = std::max(xMax, x + chunkGrid.width);
+        yMax = std::max(yMax, y + chunkGrid.height);
+    }
+    if (xMin > xMax)
+    {
+        grid.cellStart.clear();
+        grid.cellCount.clear();
+        grid.items.clear();
+        return;
+    }
+
+    grid.origin = Vector2{ header.origin.x + xMin * header.cellSize, header.origin.y + yMin * header.cellSize };
+    grid.cellSize = header.cellSize;
+    grid.invCellSize = 1.0f / header.cellSize;
+    grid.width = xMax - xMin;
+    grid.height = yMax - yMin;
+
+    // The same counting sort as a build, but counting whole chunk cells at a time
+    grid.cellStart.assign(grid.width * grid.height + 1, 0);
+    for (int index : stream.window)
+    {
+        const ObstacleGridView& chunkGrid = stream.slots[index].level.grid;
+        const int offsetX = (int)lroundf((chunkGrid.origin.x - header.origin.x) / header.cellSize) - xMin;
+        const int offsetY = (int)lroundf((chunkGrid.origin.y - header.origin.y) / header.cellSize) - yMin;
+        for (int y = 0; y < chunkGrid.height; y++)
+        {
+            for (int x = 0; x < chunkGrid.width; x++)
+            {
+                const int cell = y * chunkGrid.width + x;
+                grid.cellStart[(y + offsetY) * grid.width + x + offsetX + 1] += CellEnd(chunkGrid, cell) - CellBegin(chunkGrid, cell);
+            }
+        }
+    }
+
+    for (size_t i = 1; i < grid.cellStart.size(); i++)
+        grid.cellStart[i] += grid.cellStart[i - 1];
+
+    grid.items.resize(grid.cellStart.back());
+    grid.cellCount.assign(grid.width * grid.height, 0);
+    for (int index : stream.window)
+    {
+        const Level& level = stream.slots[index].level;
+        const ObstacleGridView& chunkGrid = level.grid;
+        const int first = (int)obstacles.size();
+        for (int i = 0; i < level.obstacles.count; i++)
+            obstacles.push_back(ObstacleAt(level.obstacles, i));
+
+        const int offsetX = (int)lroundf((chunkGrid.origin.x - header.origin.x) / header.cellSize) - xMin;
+        const int offsetY = (int)lroundf((chunkGrid.origin.y - header.origin.y) / header.cellSize) - yMin;
+        for (int y = 0; y < chunkGrid.height; y++)
+        {
+            for (int x = 0; x < chunkGrid.width; x++)
+            {
+                const int cell = y * chunkGrid.width + x;
+                const int stitched = (y + offsetY) * grid.width + x + offsetX;
+                for (int i = CellBegin(chunkGrid, cell); i < CellEnd(chunkGrid, cell); i++)
+                    grid.items[grid.cellStart[stitched] + grid.cellCount[stitched]++] = first + chunkGrid.items[i];
+            }
+        }
+    }
+}
@@ -1,37 +1,97 @@
 #include "rlImGui.h"
 #include "Physics.h"
 #include "Collision.h"
+#include "Simulation.h"
+#include "Particles.h"
+#include "Concurrency.h"
+#include "Profiler.h"
+#include "ProfilerPanel.h"
+#include "FrameStats.h"
+#include "Arena.h"
+#include "AllocTracker.h"
+#include "HotReload.h"
 
 #include <array>
 #include <vector>
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <atomic>
+#include <thread>
+#include <chrono>
 
 using namespace std;
 
-int main(void)
+// Sent by the render thread every frame; the simulation uses the latest one it has received
+struct InputMessage
+{
+    PlayerInput input;
+    bool rewind = false;
+};
+
+// Published by the simulation thread after every tick
+struct Frame
+{
+    SimulationFrame sim;
+    Vector2 nearestRecPoint{ 0.0f, 0.0f };
+    Vector2 nearestCirclePoint{ 0.0f, 0.0f };
+    bool rectangleVisible = false;
+    bool circleVisible = false;
+
+    // Tick work time over the last 10 seconds, excluding the sleep between ticks
+    FrameTimeSummary tickTimes;
+    int tickHitches = 0;
+
+    // Heap allocations during the tick, all zero unless built with ALLOC_TRACKER_ENABLED
+    AllocFrameStats tickAllocations;
+};
+
+// Everything the two threads share; each channel has exactly one writer and one reader
+struct SimulationChannels
+{
+    SpscQueue<InputMessage> inputs;     // render -> simulation
+    SpscQueue<HitEvent> hits;           // simulation -> render, every hit so no sparks are missed
+    TripleBuffer<Frame> frames;         // simulation -> render, only the latest matters
+    std::atomic<bool> running{ true };
+};
+
+// sunshine [obstacles]
+// obstacles is a text obstacle file, a binary level or a world to stream, by default the
+// game's own obstacles.txt
+int main(int argc, char** argv)
 {
     const int screenWidth = 1280;
     const int screenHeight = 720;
     InitWindow(screenWidth, screenHeight, "Sunshine");
+    InitAudioDevice();
     rlImGuiSetup(true);
 
-    vector<Rectangle> obstacles;
-    std::ifstream inFile("../game/assets/data/obstacles.txt");
-    while (!inFile.eof())
-    {
-        Rectangle obstacle;
-        inFile >> obstacle.x >> obstacle.y >> obstacle.width >> obstacle.height;
-        obstacles.push_back(obstacle);
-    }
-    inFile.close();
+    // Owned by the simulation thread once it starts
+    const char* obstaclesPath = argc > 1 ? argv[1] : "../game/assets/data/obstacles.txt";
+    Simulation sim;
+    WorldStream world;
+    if (ReadFileMagic(obstaclesPath) != worldMagic)
+        LoadLevel(sim, obstaclesPath);
+    else if (StartWorldStream(world, obstaclesPath, 1, 2))
+        sim.world = &world;
+    InitProjectiles(sim.projectiles, 50000, 4096);
+
+    // Hold the left mouse button to fire
+    Sound laserSound = LoadSound("../game/assets/audio/laser.mp3");
+    float laserSoundCooldown = 0.0f;
+
+    // Obstacles live in GPU buffers; the one the laser is touching is drawn darker
+    // Only those near the view are drawn, so the cost follows the screen rather than the map
+    CulledGeometry obstacleGeometry;
+    int highlightedObstacle = -1;
+
+    // Sparks where the laser hits, purely visual so they use their own generator
+    ParticlePool particles;
+    LoadParticles(particles, 200000);
+    Rng effectsRng;
 
-    float playerRotation = 0.0f;
     const float playerWidth = 60.0f;
     const float playerHeight = 40.0f;
-    const float playerRange = 1000.0f;
-    const float playerRotationSpeed = 100.0f;
 
     const char* recText = "Nearest to Rectangle";
     const char* circleText = "Nearest to Circle";
@@ -44,68 +104,356 @@ int main(void)
     const Rectangle rectangle{ 1000.0f, 500.0f, 160.0f, 90.0f };
     const Circle circle{ { 1000.0f, 250.0f }, 50.0f };
 
+    // Collision queries run with the simulation, so a slow query never holds up a frame
+    auto captureFrame = [&](Frame& frame)
+    {
+        LaserResult laser;
+        {
+            PROFILE_ZONE("Collision queries");
+            ALLOC_TAG("Collision queries");
+            laser = CastLaser(sim);
+            frame.rectangleVisible = IsRectangleVisible(laser.start, laser.end, rectangle, *sim.obstacles);
+            frame.circleVisible = IsCircleVisible(laser.start, laser.end, circle, *sim.obstacles);
+        }
+        {
+            // Obstacles are only copied when they change, which isn't a steady-state frame
+            ALLOC_TAG("Capture frame");
+            ALLOC_ALLOW_IF(frame.sim.obstaclesVersion != sim.obstaclesVersion);
+            CaptureFrame(frame.sim, sim, laser);
+        }
+        frame.nearestRecPoint = NearestPoint(laser.start, laser.end,
+            { rectangle.x + rectangle.width * 0.5f, rectangle.y + rectangle.height * 0.5f });
+        frame.nearestCirclePoint = NearestPoint(laser.start, laser.end, circle.position);
+    };
+
+    SimulationChannels channels;
+    InitQueue(channels.inputs, 64);
+    InitQueue(channels.hits, 16384);
+    UpdateObstacleGrid(sim);
+    captureFrame(WriteSlot(channels.frames));
+    Publish(channels.frames);
+
+    // Saving the obstacle file updates the running game, edited in place rather than reloaded
+    // Worlds are only ever read a chunk at a time, so they aren't reloaded
+    ObstacleReloader reloader;
+    if (sim.world == nullptr)
+        StartObstacleReloader(reloader, obstaclesPath, sim.obstacles, sim.obstaclesVersion);
+
+    // The simulation ticks at a fixed 60 Hz on its own thread and publishes a frame after
+    // every tick; rendering draws whichever frame is newest, so the two overlap on separate cores
+    std::thread simulationThread([&]()
+    {
+        PROFILE_THREAD("Simulation");
+        using Clock = std::chrono::steady_clock;
+        const float tickDt = 1.0f / 60.0f;
+        const Clock::duration tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(tickDt));
+
+        // 10 seconds of history, hold R to rewind
+        SnapshotRing history;
+        InitSnapshots(history, 600);
+
+        // A tick longer than its own timestep means the simulation is falling behind
+        FrameStats tickStats;
+        InitFrameStats(tickStats, 600, tickDt * 1000.0f);
+
+        InputMessage latest;
+        std::vector<ObstacleReload> reloads;
+        Clock::time_point next = Clock::now();
+        while (channels.running.load(std::memory_order_relaxed))
+        {
+            const Clock::time_point tickStart = Clock::now();
+            InputMessage message;
+            while (Pop(channels.inputs, message))
+                latest = message;
+
+            TakeObstacleReloads(reloader, reloads);
+            {
+                ALLOC_TAG("Obstacle reload");
+                ALLOC_ALLOW_IF(!reloads.empty());
+                for (const ObstacleReload& reload : reloads)
+                    ApplyObstacleEdit(sim, reload.edit, reload.obstacles);
+            }
+
+            if (latest.rewind)
+            {
+                PROFILE_ZONE("Rewind");
+                ALLOC_TAG("Rewind");
+                // A streamed world's window is stitched into a new obstacle set if the restored one is older
+                ALLOC_ALLOW_IF(sim.world != nullptr);
+                if (RestoreSnapshot(history, sim, 1))
+                    DiscardSnapshots(history, 1);
+                UpdateObstacleGrid(sim);
+            }
+            else
+            {
+                {
+                    // Reaching another chunk of a streamed world stitches a window that may outgrow the last
+                    ALLOC_TAG("Tick");
+                    ALLOC_ALLOW_IF(sim.world != nullptr && WorldWindowMoves(*sim.world, latest.input.position));
+                    Tick(sim, latest.input, tickDt);
+                }
+                {
+                    PROFILE_ZONE("Save snapshot");
+                    ALLOC_TAG("Save snapshot");
+                    SaveSnapshot(history, sim);
+                }
+
+                // Sparks are cosmetic, so hits the render thread can't keep up with are dropped
+                const ProjectilePool& projectiles = sim.projectiles;
+                for (int i = 0; i < projectiles.hitCount; i++)
+                    Push(channels.hits, projectiles.hits[i]);
+                PROFILE_COUNTER("Projectiles", projectiles.count);
+                PROFILE_COUNTER("Hits", projectiles.hitCount);
+            }
+
+            Frame& frame = WriteSlot(channels.frames);
+            captureFrame(frame);
+            RecordFrameTime(tickStats, std::chrono::duration<float>(Clock::now() - tickStart).count());
+            frame.tickTimes = Summarize(tickStats.window);
+            frame.tickHitches = tickStats.hitches;
+            frame.tickAllocations = EndAllocFrame();
+
+            // Past warm-up a tick shouldn't allocate (fails only with ALLOC_TRACKER_ASSERT)
+            ForbidAllocations(tickStats.session.total > 120);
+            Publish(channels.frames);
+
+            // Skip ahead instead of spiralling if we fell far behind
+            // Sleep is outside every zone, so it shows as a gap in the flame graph
+            next += tickDuration;
+            const Clock::time_point now = Clock::now();
+            if (now - next > tickDuration * 15)
+                next = now;
+            std::this_thread::sleep_until(next);
+        }
+    });
+
+    // Mouse wheel zooms around the cursor, right drag pans
+    Camera2D camera{};
+    camera.zoom = 1.0f;
+
+    PROFILE_THREAD("Render");
+
+    // Grave shows the ImGui demo, F1 the profiler, F2 starts and stops a trace capture
+    ProfilerPanel profilerPanel;
+
+    // Scratch memory for the render thread's per-frame temporaries, reset at the end of each frame
+    FrameArenas frameArenas;
+    InitFrameArenas(frameArenas, 1 << 20);
+
+    // Frames over 50 ms dump the last two seconds of profiling to hitch_N.trace.json
+    FrameStats frameStats;
+    InitFrameStats(frameStats, 600, 50.0f);
+
+    bool profilerGUI = false;
     bool demoGUI = false;
     SetTargetFPS(60);
     while (!WindowShouldClose())
     {
         float dt = GetFrameTime();
-        if (IsKeyDown(KEY_E))
-            playerRotation += playerRotationSpeed * dt;
-        if (IsKeyDown(KEY_Q))
-            playerRotation -= playerRotationSpeed * dt;
-
-        const Vector2 playerPosition = GetMousePosition();
-        const Vector2 playerDirection = Direction(playerRotation * DEG2RAD);
-        const Vector2 playerEnd = playerPosition + playerDirection * playerRange;
-        const Rectangle playerRec{ playerPosition.x, playerPosition.y, playerWidth, playerHeight };
+        if (RecordFrameTime(frameStats, dt))
+        {
+            ALLOC_ALLOW_IF(true);
+            DumpProfileHistory(TextFormat("hitch_%i.trace.json", frameStats.hitches), 120);
+        }
 
-        const Vector2 nearestRecPoint = NearestPoint(playerPosition, playerEnd,
-            { rectangle.x + rectangle.width * 0.5f, rectangle.y + rectangle.height * 0.5f });
-        const Vector2 nearestCirclePoint = NearestPoint(playerPosition, playerEnd, circle.position);
-        Vector2 poi;
+#if ALLOC_TRACKER_ENABLED
+        // Like dt, the counts are for the frame that just ended
+        // Past warm-up a frame shouldn't allocate (fails only with ALLOC_TRACKER_ASSERT)
+        const AllocFrameStats frameAllocations = EndAllocFrame();
+        ForbidAllocations(frameStats.session.total > 120);
+#endif
 
-        const bool collision = NearestIntersection(playerPosition, playerEnd, obstacles, poi);
-        const bool rectangleVisible = IsRectangleVisible(playerPosition, playerEnd, rectangle, obstacles);
-        const bool circleVisible = IsCircleVisible(playerPosition, playerEnd, circle, obstacles);
+        if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT))
+            camera.target = camera.target - GetMouseDelta() * (1.0f / camera.zoom);
+        const float wheel = GetMouseWheelMove();
+        if (wheel != 0.0f)
+        {
+            const Vector2 mouse = GetMousePosition();
+            const Vector2 anchor = GetScreenToWorld2D(mouse, camera);
+            camera.offset = mouse;
+            camera.target = anchor;
+            camera.zoom = Clamp(camera.zoom * powf(1.25f, wheel), 0.05f, 10.0f);
+        }
 
-        BeginDrawing();
-        ClearBackground(RAYWHITE);
+        // If the queue is full the simulation is stalled, and it only needs the latest input anyway
+        InputMessage message;
+        message.input.position = GetScreenToWorld2D(GetMousePosition(), camera);
+        message.input.rotateCW = IsKeyDown(KEY_E);
+        message.input.rotateCCW = IsKeyDown(KEY_Q);
+        message.input.fire = IsMouseButtonDown(MOUSE_BUTTON_LEFT);
+        message.rewind = IsKeyDown(KEY_R);
+        Push(channels.inputs, message);
 
-        // Render player
-        DrawRectanglePro(playerRec, { playerWidth * 0.5f, playerHeight * 0.5f }, playerRotation, PURPLE);
-        DrawLine(playerPosition.x, playerPosition.y, playerEnd.x, playerEnd.y, BLUE);
-        DrawCircleV(playerPosition, 10.0f, BLUE);
-
-        // Render geometry
-        for (const Rectangle& obstacle : obstacles)
-            DrawRectangleRec(obstacle, GREEN);
-        DrawRectangleRec(rectangle, rectangleVisible ? GREEN : RED);
-        DrawCircleV(circle.position, circle.radius, circleVisible ? GREEN : RED);
-
-        // Render labels
-        DrawText(circleText, nearestCirclePoint.x - circleTextWidth * 0.5f, nearestCirclePoint.y - fontSize * 2, fontSize, BLUE);
-        DrawCircleV(nearestRecPoint, 10.0f, BLUE);
-        DrawText(recText, nearestRecPoint.x - recTextWidth * 0.5f, nearestRecPoint.y - fontSize * 2, fontSize, BLUE);
-        DrawCircleV(nearestCirclePoint, 10.0f, BLUE);
+        laserSoundCooldown -= dt;
+        if (message.input.fire && !message.rewind && laserSoundCooldown <= 0.0f)
+        {
+            PlaySound(laserSound);
+            laserSoundCooldown = 0.1f;
+        }
+
+        // Keeps drawing the previous frame if the simulation hasn't published a new one
+        Acquire(channels.frames);
+        const Frame& frame = ReadSlot(channels.frames);
+        const SimulationFrame& state = frame.sim;
+
+        const float playerRotation = state.playerRotation;
+        const Vector2 playerPosition = state.playerPosition;
+        const LaserResult& laser = state.laser;
+        const Vector2 playerEnd = laser.end;
+        const Rectangle playerRec{ playerPosition.x, playerPosition.y, playerWidth, playerHeight };
+
+        const Vector2 nearestRecPoint = frame.nearestRecPoint;
+        const Vector2 nearestCirclePoint = frame.nearestCirclePoint;
+        const Vector2 poi = laser.poi;
+        const bool collision = laser.hit;
         if (collision)
+            EmitParticles(particles, effectsRng, poi, playerPosition - poi, 0.8f, 100.0f, 400.0f, 0.25f, 1.0f, ORANGE, 16);
+        HitEvent hit;
+        while (Pop(channels.hits, hit))
+            EmitParticles(particles, effectsRng, hit.position, hit.velocity * -1.0f, 1.2f, 50.0f, 250.0f, 0.1f, 0.4f, YELLOW, 4);
         {
-            DrawText(poiText, poi.x - poiTextWidth * 0.5f, poi.y - fontSize * 2, fontSize, BLUE);
-            DrawCircleV(poi, 10.0f, BLUE);
+            PROFILE_ZONE("Particles");
+            ALLOC_TAG("Particles");
+            UpdateParticles(particles, dt, gravity, 1.0f);
         }
+        PROFILE_COUNTER("Particles", particles.count);
+
+        BeginDrawing();
+        ClearBackground(RAYWHITE);
+        BeginMode2D(camera);
+        {
+            PROFILE_ZONE("Draw world");
+
+            // Render player
+            DrawRectanglePro(playerRec, { playerWidth * 0.5f, playerHeight * 0.5f }, playerRotation, PURPLE);
+            DrawLine(playerPosition.x, playerPosition.y, playerEnd.x, playerEnd.y, BLUE);
+            DrawCircleV(playerPosition, 10.0f, BLUE);
+
+            // Render geometry
+            {
+                PROFILE_ZONE("Draw obstacles");
+                ALLOC_TAG("Draw obstacles");
+                ALLOC_ALLOW_IF(obstacleGeometry.version != state.obstaclesVersion);
+                if (obstacleGeometry.version != state.obstaclesVersion)
+                {
+                    // Indices change with the obstacles, so un-highlight while the old one is still valid
+                    SetCulledGeometryColor(obstacleGeometry, highlightedObstacle, GREEN);
+                    highlightedObstacle = -1;
+                    if (!EditCulledGeometry(obstacleGeometry, state.obstacleEdits, state.obstaclesVersion, GREEN))
+                        UpdateCulledGeometry(obstacleGeometry, state.obstacleGrid, *state.obstacles, state.obstaclesVersion, GREEN, CurrentArena(frameArenas));
+                }
+                if (laser.obstacle != highlightedObstacle)
+                {
+                    SetCulledGeometryColor(obstacleGeometry, highlightedObstacle, GREEN);
+                    SetCulledGeometryColor(obstacleGeometry, laser.obstacle, DARKGREEN);
+                    highlightedObstacle = laser.obstacle;
+                }
+                const Vector2 viewMin = GetScreenToWorld2D({ 0.0f, 0.0f }, camera);
+                const Vector2 viewMax = GetScreenToWorld2D({ (float)GetScreenWidth(), (float)GetScreenHeight() }, camera);
+                DrawCulledGeometry(obstacleGeometry, { viewMin.x, viewMin.y, viewMax.x - viewMin.x, viewMax.y - viewMin.y }, CurrentArena(frameArenas));
+            }
+            DrawRectangleRec(rectangle, frame.rectangleVisible ? GREEN : RED);
+            DrawCircleV(circle.position, circle.radius, frame.circleVisible ? GREEN : RED);
+
+            // Render projectiles as short tracers
+            {
+                PROFILE_ZONE("Draw projectiles");
+                for (int i = 0; i < state.projectileCount; i++)
+                {
+                    const Vector2 head{ state.px[i], state.py[i] };
+                    const Vector2 tail = head - Vector2{ state.vx[i], state.vy[i] } * 0.01f;
+                    DrawLineV(tail, head, MAROON);
+                }
+            }
+
+            {
+                PROFILE_ZONE("Draw particles");
+                DrawParticles(particles);
+            }
+
+            // Render labels
+            DrawText(circleText, nearestCirclePoint.x - circleTextWidth * 0.5f, nearestCirclePoint.y - fontSize * 2, fontSize, BLUE);
+            DrawCircleV(nearestRecPoint, 10.0f, BLUE);
+            DrawText(recText, nearestRecPoint.x - recTextWidth * 0.5f, nearestRecPoint.y - fontSize * 2, fontSize, BLUE);
+            DrawCircleV(nearestCirclePoint, 10.0f, BLUE);
+            if (collision)
+            {
+                DrawText(poiText, poi.x - poiTextWidth * 0.5f, poi.y - fontSize * 2, fontSize, BLUE);
+                DrawCircleV(poi, 10.0f, BLUE);
+            }
+        }
+        EndMode2D();
+
+        // Render culling stats in screen space
+        DrawText(TextFormat("Obstacles submitted %i, culled %i in %i ranges, zoom %.2f",
+            obstacleGeometry.candidates, obstacleGeometry.culled, obstacleGeometry.ranges, camera.zoom), 10, 10, 20, DARKGRAY);
+
+        // Render frame and tick time percentiles over the last 600 frames/ticks
+        const FrameTimeSummary frameTimes = Summarize(frameStats.window);
+        DrawText(TextFormat("Frame ms p50 %.1f  p95 %.1f  p99 %.1f  max %.1f  hitches %i",
+            frameTimes.p50, frameTimes.p95, frameTimes.p99, frameTimes.max, frameStats.hitches), 10, 35, 20, DARKGRAY);
+        DrawText(TextFormat("Tick ms  p50 %.1f  p95 %.1f  p99 %.1f  max %.1f  hitches %i",
+            frame.tickTimes.p50, frame.tickTimes.p95, frame.tickTimes.p99, frame.tickTimes.max, frame.tickHitches), 10, 60, 20, DARKGRAY);
+#if ALLOC_TRACKER_ENABLED
+        const AllocFrameStats& tickAllocations = frame.tickAllocations;
+        DrawText(TextFormat("Allocs frame %i (%i B, most in %s)  tick %i (%i B, most in %s)",
+            (int)frameAllocations.allocations, (int)frameAllocations.bytes, frameAllocations.topTag ? frameAllocations.topTag : "-",
+            (int)tickAllocations.allocations, (int)tickAllocations.bytes, tickAllocations.topTag ? tickAllocations.topTag : "-"), 10, 85, 20, DARKGRAY);
+#endif
 
         // Render GUI
         if (IsKeyPressed(KEY_GRAVE)) demoGUI = !demoGUI;
-        if (demoGUI)
+        if (IsKeyPressed(KEY_F1)) profilerGUI = !profilerGUI;
+        if (IsKeyPressed(KEY_F2))
         {
+            ALLOC_ALLOW_IF(true);
+            if (GetProfiler().capturing) StopTraceCapture();
+            else StartTraceCapture("sunshine.trace.json", 0);
+        }
+        if (demoGUI || profilerGUI)
+        {
+            // Debug UI, not part of the steady-state frame
+            PROFILE_ZONE("ImGui");
+            ALLOC_TAG("ImGui");
+            ALLOC_ALLOW_IF(true);
             rlImGuiBegin();
-            ImGui::ShowDemoWindow(nullptr);
+            if (demoGUI) ImGui::ShowDemoWindow(&demoGUI);
+            if (profilerGUI) DrawProfilerWindow(profilerPanel, &profilerGUI, CurrentArena(frameArenas));
             rlImGuiEnd();
         }
 
-        EndDrawing();
+        {
+            PROFILE_ZONE("Present");
+            EndDrawing();
+        }
+        PROFILE_COUNTER("Obstacles submitted", obstacleGeometry.candidates);
+        {
+            // Grows the history and capture buffers until they reach their working size
+            ALLOC_TAG("Profiler");
+            ALLOC_ALLOW_IF(true);
+            PROFILE_FRAME();
+        }
+        {
+            // Only allocates if the frame outgrew the arena, which then grows to fit
+            ALLOC_TAG("Frame arena");
+            ALLOC_ALLOW_IF(true);
+            NextFrameArena(frameArenas);
+        }
     }
+    ForbidAllocations(false);
+
+    channels.running.store(false, std::memory_order_relaxed);
+    simulationThread.join();
+    StopObstacleReloader(reloader);
+    StopWorldStream(world);
+    ProfilerShutdown();
 
+    UnloadCulledGeometry(obstacleGeometry);
+    DestroyFrameArenas(frameArenas);
+    UnloadParticles(particles);
+    UnloadSound(laserSound);
     rlImGuiShutdown();
+    CloseAudioDevice();
     CloseWindow();
 
     return 0;
@@ -0,0 +1,129 @@
+#include "raylib.h"
+#include "Collision.h"
+#include "LevelFile.h"
+#include "WorldFile.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Converts a text obstacle file into a binary level (see LevelFile.h), building its obstacle
+// grid ahead of time so loading the level never has to.
+//
+// levelconvert input.txt output.level [--cell-size N] [--no-grid]
+// levelconvert input.txt output.world --world SIZE [--cell-size N]
+// --cell-size is the grid's starting cell size (default 64, what the game builds); like at
+// runtime it is coarsened for sparse maps.
+// --world writes a world instead (see WorldFile.h), cut into square chunks SIZE world units on a
+// side (rounded up to whole cells), not a number of chunks; their grids keep the cell size as given.
+
+using Clock = std::chrono::steady_clock;
+
+double Milliseconds(Clock::duration duration)
+{
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+int main(int argc, char** argv)
+{
+    const char* inputPath = nullptr;
+    const char* outputPath = nullptr;
+    float cellSize = 64.0f;
+    bool withGrid = true;
+    float chunkSize = 0.0f;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = i + 1 < argc;
+        if (hasValue && strcmp(argv[i], "--cell-size") == 0) cellSize = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--no-grid") == 0) withGrid = false;
+        else if (hasValue && strcmp(argv[i], "--world") == 0) chunkSize = (float)atof(argv[++i]);
+        else if (argv[i][0] != '-' && inputPath == nullptr) inputPath = argv[i];
+        else if (argv[i][0] != '-' && outputPath == nullptr) outputPath = argv[i];
+        else
+        {
+            inputPath = nullptr;
+            break;
+        }
+    }
+    if (inputPath == nullptr || outputPath == nullptr || cellSize <= 0.0f || chunkSize < 0.0f || (chunkSize > 0.0f && !withGrid))
+    {
+        printf("usage: %s input.txt output.level [--cell-size N] [--no-grid]\n", argv[0]);
+        printf("       %s input.txt output.world --world SIZE [--cell-size N]\n", argv[0]);
+        printf("SIZE is the side of each chunk in world units, e.g. 1024\n");
+        return 1;
+    }
+
+    Clock::time_point start = Clock::now();
+    std::vector<Rectangle> obstacles;
+    if (!LoadObstacles(inputPath, obstacles)) return 1;
+    const double parseMs = Milliseconds(Clock::now() - start);
+
+    if (chunkSize > 0.0f)
+    {
+        start = Clock::now();
+        if (!SaveWorld(outputPath, obstacles, chunkSize, cellSize)) return 1;
+        const double worldMs = Milliseconds(Clock::now() - start);
+
+        // Read every chunk back so a bad write fails here rather than in the game
+        World world;
+        if (!OpenWorld(world, outputPath)) return 1;
+        const WorldHeader& header = world.header;
+        std::vector<char> data;
+        Level chunk;
+        size_t count = 0;
+        int largest = 0;
+        for (int i = 0; i < header.chunksX * header.chunksY; i++)
+        {
+            if (!ReadWorldChunk(world, i, data, chunk)) return 1;
+            count += chunk.obstacles.count;
+            largest = std::max(largest, chunk.obstacles.count);
+        }
+        if (count != obstacles.size())
+        {
+            printf("%s: obstacle count differs after writing\n", outputPath);
+            return 1;
+        }
+
+        printf("%zu obstacles, %dx%d chunks of %.0f, at most %d obstacles in one\n", obstacles.size(),
+            header.chunksX, header.chunksY, header.chunkSize, largest);
+        printf("%.1f KiB, parse %.1f ms, world %.1f ms\n", header.fileSize / 1024.0, parseMs, worldMs);
+        CloseWorld(world);
+        return 0;
+    }
+
+    start = Clock::now();
+    ObstacleGrid grid;
+    if (withGrid) BuildObstacleGrid(grid, obstacles, cellSize);
+    const double gridMs = Milliseconds(Clock::now() - start);
+
+    if (!SaveLevel(outputPath, obstacles, withGrid ? &grid : nullptr)) return 1;
+
+    // Read it back so a bad write fails here rather than at startup
+    start = Clock::now();
+    Level level;
+    if (!MapLevel(level, outputPath)) return 1;
+    const double mapMs = Milliseconds(Clock::now() - start);
+    if (level.obstacles.count != (int)obstacles.size())
+    {
+        printf("%s: obstacle count differs after writing\n", outputPath);
+        return 1;
+    }
+    for (int i = 0; i < level.obstacles.count; i++)
+    {
+        const Rectangle r = ObstacleAt(level.obstacles, i);
+        if (memcmp(&r, &obstacles[i], sizeof(Rectangle)) != 0)
+        {
+            printf("%s: obstacle %d differs after writing\n", outputPath, i);
+            return 1;
+        }
+    }
+
+    printf("%zu obstacles", obstacles.size());
+    if (withGrid) printf(", %dx%d grid of %.0f cells", grid.width, grid.height, grid.cellSize);
+    printf(", %.1f KiB\n", level.file.size / 1024.0);
+    printf("parse %.1f ms, grid %.1f ms, map %.3f ms\n", parseMs, gridMs, mapMs);
+    UnmapLevel(level);
+    return 0;
+}
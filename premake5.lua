@@ -12,6 +12,57 @@ newoption
 	default = "opengl33"
 }
 
+newoption
+{
+	trigger = "simd",
+	value = "INSTRUCTION_SET",
+	description = "SIMD backend for the 4-wide math in game/src/Math.h",
+	allowed = {
+		{ "none", "Scalar only"},
+		{ "sse4", "SSE4.1"},
+		{ "avx2", "The SSE4.1 code compiled with VEX encoding for AVX2 machines; no 256-bit paths"}
+	},
+	default = "sse4"
+}
+
+newoption
+{
+	trigger = "cppstd",
+	value = "STANDARD",
+	description = "C++ standard; 17 and later make most of game/src/Math.h constexpr",
+	allowed = {
+		{ "11", "C++11"},
+		{ "17", "C++17"},
+		{ "20", "C++20"}
+	},
+	default = "11"
+}
+
+newoption
+{
+	trigger = "profiler",
+	value = "MODE",
+	description = "scoped CPU profiler zones in game/src/Profiler.h",
+	allowed = {
+		{ "on", "Zones recorded, F1 shows the profiler"},
+		{ "off", "Zones compiled out"}
+	},
+	default = "on"
+}
+
+newoption
+{
+	trigger = "alloctracker",
+	value = "MODE",
+	description = "heap allocation tracking in game/src/AllocTracker.h",
+	allowed = {
+		{ "off", "Global operator new untouched"},
+		{ "on", "Allocations per frame and tick in the overlay"},
+		{ "assert", "Also abort on any allocation in a steady-state frame"}
+	},
+	default = "off"
+}
+
 function define_C()
 	language "C"
 end
@@ -90,6 +141,31 @@ workspace "sunshine"
 	check_raylib()
 	check_imgui()
 
+	filter "options:simd=sse4"
+		vectorextensions "SSE4.1"
+		defines { "RM_SIMD_SSE4" }
+
+	filter "options:simd=avx2"
+		vectorextensions "AVX2"
+		defines { "RM_SIMD_AVX2" }
+
+	filter "options:profiler=off"
+		defines { "PROFILER_ENABLED=0" }
+
+	filter "options:alloctracker=on"
+		defines { "ALLOC_TRACKER_ENABLED=1" }
+
+	filter "options:alloctracker=assert"
+		defines { "ALLOC_TRACKER_ENABLED=1", "ALLOC_TRACKER_ASSERT=1" }
+
+	filter "options:cppstd=17"
+		cppdialect "C++17"
+
+	filter "options:cppstd=20"
+		cppdialect "C++20"
+
+	filter {}
+
 	include ("raylib_premake5.lua")
 		
 project "rlImGui"
@@ -160,3 +236,68 @@ project "game"
 	link_raylib()
 	links {"rlImGui"}
 	includedirs {"./", "imgui", "imgui-master" }
+
+-- Windowless simulation runner for machines without a GPU
+project "headless"
+	kind "ConsoleApp"
+	language "C++"
+	location "_build"
+	targetdir "_bin/%{cfg.buildcfg}"
+
+	vpaths
+	{
+		["Header Files"] = {"game/src/**.h"},
+		["Source Files"] = {"game/headless/**.cpp"},
+	}
+	files {"game/headless/**.cpp", "game/src/**.h"}
+	link_raylib()
+	includedirs {"./", "game/src"}
+
+-- Converts text obstacle files to binary levels
+project "levelconvert"
+	kind "ConsoleApp"
+	language "C++"
+	location "_build"
+	targetdir "_bin/%{cfg.buildcfg}"
+
+	vpaths
+	{
+		["Header Files"] = {"game/src/**.h"},
+		["Source Files"] = {"game/tools/levelconvert.cpp"},
+	}
+	files {"game/tools/levelconvert.cpp", "game/src/**.h"}
+	link_raylib()
+	includedirs {"./", "game/src"}
+
+-- Console benchmarks, one per source file in game/bench
+function bench_project(name, uses_raylib)
+	project ("bench-" .. name)
+		kind "ConsoleApp"
+		language "C++"
+		location "_build"
+		targetdir "_bin/%{cfg.buildcfg}"
+
+		vpaths
+		{
+			["Header Files"] = {"game/bench/**.h", "game/src/**.h"},
+			["Source Files"] = {"game/bench/**.cpp"},
+		}
+		files {"game/bench/" .. name .. ".cpp", "game/bench/**.h"}
+		includedirs {"./", "game/src", "game/bench"}
+		if uses_raylib then
+			link_raylib()
+		end
+end
+
+group "Benchmarks"
+	bench_project("integrators", false)
+	bench_project("snapshots", true)
+	bench_project("vectors", false)
+	bench_project("matrices", false)
+	bench_project("precision", false)
+	bench_project("math", false)
+	bench_project("obstacles", true)
+	bench_project("world", true)
+	bench_project("steering", true)
+	bench_project("pool", false)
+group ""